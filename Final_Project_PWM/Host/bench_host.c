@@ -0,0 +1,305 @@
+/*
+ * bench_host.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ *
+ *  Host side of the kernel microbenchmarks (Inc/bench.h): times every entry of
+ *  bench_table against the simulated board, the way Google Benchmark does. The
+ *  iteration count grows until a run lasts --benchmark_min_time, the run is repeated
+ *  --benchmark_repetitions times and mean / median / stddev aggregates are added.
+ *
+ *  Per run:
+ *    real_time, cpu_time   host ns per call (register accesses go through the simulator)
+ *    sim_cycles_per_op     simulated target cycles per call: peripheral accesses and
+ *                          intrinsics only, not the instructions in between; the exact
+ *                          target figure comes from Bench_Run() (BENCH_ENABLE = 1)
+ *
+ *  Usage: bench_host [--benchmark_filter=substr] [--benchmark_min_time=s]
+ *                    [--benchmark_repetitions=n] [--benchmark_out=results.json]
+ */
+#include "sim.h"
+#include "bench.h"
+#include "arming.h"
+#include "board_pins.h"
+#include "LED.h"
+#include "PWM.h"
+#include "timebase.h"
+#include "timer_wheel.h"
+#include "trace.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define REPETITIONS_MAX     32U
+#define ITERATIONS_MAX      1000000000ULL
+
+typedef struct {
+    uint64_t iterations;
+    double   real_ns;           // per call
+    double   cpu_ns;
+    double   sim_cycles;
+} run_t;
+
+static const char *filter       = "";
+static double      min_time     = 0.1;
+static uint32_t    repetitions  = 3;
+static const char *out_path     = NULL;
+
+static run_t    runs[BENCH_COUNT][REPETITIONS_MAX];
+static uint32_t selected[BENCH_COUNT];
+
+static double now_s(clockid_t clock) {
+
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+//-------------------------------------------------------------------------------------------
+//  measure
+//  One run of 'iterations' calls.
+//-------------------------------------------------------------------------------------------
+static run_t measure(const bench_t *b, uint64_t iterations) {
+
+    uint64_t cycles = Sim_Cycles();
+    double   real   = now_s(CLOCK_MONOTONIC);
+    double   cpu    = now_s(CLOCK_PROCESS_CPUTIME_ID);
+
+    for (uint64_t done = 0; done < iterations; ) {
+        uint32_t n = (iterations - done > UINT32_MAX) ? UINT32_MAX : (uint32_t)(iterations - done);
+        b->run(n);
+        done += n;
+    }
+
+    run_t r;
+    r.iterations = iterations;
+    r.real_ns    = (now_s(CLOCK_MONOTONIC) - real) * 1e9;
+    r.cpu_ns     = (now_s(CLOCK_PROCESS_CPUTIME_ID) - cpu) * 1e9;
+    r.sim_cycles = (double)(Sim_Cycles() - cycles);
+    return r;
+}
+
+//-------------------------------------------------------------------------------------------
+//  bench_one
+//  Grow the iteration count (at most 10x per step) until a run reaches min_time, then
+//  take the timed repetitions at that count.
+//-------------------------------------------------------------------------------------------
+static void bench_one(uint32_t id) {
+
+    const bench_t *b          = &bench_table[id];
+    uint64_t       iterations = 1;
+    run_t          r;
+
+    for (;;) {
+        r = measure(b, iterations);
+        double seconds = r.real_ns * 1e-9;
+        if (seconds >= min_time || iterations >= ITERATIONS_MAX) {
+            break;
+        }
+        double   scale = (seconds > 0.0) ? min_time * 1.4 / seconds : 10.0;
+        uint64_t next  = (uint64_t)((double)iterations * ((scale < 10.0) ? scale : 10.0));
+        iterations = (next > iterations) ? next : iterations + 1U;
+        if (iterations > ITERATIONS_MAX) {
+            iterations = ITERATIONS_MAX;
+        }
+    }
+
+    for (uint32_t k = 0; k < repetitions; k++) {
+        r = measure(b, iterations);
+        r.real_ns    /= (double)iterations;
+        r.cpu_ns     /= (double)iterations;
+        r.sim_cycles /= (double)iterations;
+        runs[id][k] = r;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  Aggregates over the repetitions
+//-------------------------------------------------------------------------------------------
+static int cmp_double(const void *a, const void *b) {
+
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double aggregate(const char *name, const double *v, uint32_t n) {
+
+    double sorted[REPETITIONS_MAX];
+    double mean = 0.0, var = 0.0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        mean += v[i] / n;
+    }
+    if (!strcmp(name, "mean")) {
+        return mean;
+    }
+    if (!strcmp(name, "median")) {
+        memcpy(sorted, v, n * sizeof(double));
+        qsort(sorted, n, sizeof(double), cmp_double);
+        return (n % 2U) ? sorted[n / 2U] : (sorted[n / 2U - 1U] + sorted[n / 2U]) / 2.0;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        var += (v[i] - mean) * (v[i] - mean);
+    }
+    return (n > 1U) ? sqrt(var / (n - 1U)) : 0.0;
+}
+
+//-------------------------------------------------------------------------------------------
+//  Google Benchmark JSON
+//-------------------------------------------------------------------------------------------
+static void json_entry(FILE *f, int *first, const char *name, const char *run_name,
+                       const char *aggregate_name, uint64_t iterations,
+                       double real, double cpu, double cycles) {
+
+    fprintf(f, "%s    {\n", *first ? "" : ",\n");
+    fprintf(f, "      \"name\": \"%s\",\n", name);
+    fprintf(f, "      \"run_name\": \"%s\",\n", run_name);
+    if (aggregate_name) {
+        fprintf(f, "      \"run_type\": \"aggregate\",\n");
+        fprintf(f, "      \"aggregate_name\": \"%s\",\n", aggregate_name);
+    }
+    else {
+        fprintf(f, "      \"run_type\": \"iteration\",\n");
+    }
+    fprintf(f, "      \"repetitions\": %u,\n", repetitions);
+    fprintf(f, "      \"iterations\": %llu,\n", (unsigned long long)iterations);
+    fprintf(f, "      \"real_time\": %.4f,\n", real);
+    fprintf(f, "      \"cpu_time\": %.4f,\n", cpu);
+    fprintf(f, "      \"time_unit\": \"ns\",\n");
+    fprintf(f, "      \"sim_cycles_per_op\": %.2f\n", cycles);
+    fprintf(f, "    }");
+    *first = 0;
+}
+
+static int write_json(const char *path) {
+
+    static const char *const aggregates[] = { "mean", "median", "stddev" };
+    FILE  *f = fopen(path, "w");
+    char   host[64] = "";
+    char   date[32];
+    time_t t = time(NULL);
+    int    first = 1;
+
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    gethostname(host, sizeof(host) - 1U);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&t));
+
+    fprintf(f, "{\n  \"context\": {\n");
+    fprintf(f, "    \"date\": \"%s\",\n", date);
+    fprintf(f, "    \"host_name\": \"%s\",\n", host);
+    fprintf(f, "    \"executable\": \"bench_host\",\n");
+    fprintf(f, "    \"num_cpus\": %ld,\n", sysconf(_SC_NPROCESSORS_ONLN));
+    fprintf(f, "    \"simulated_clock_hz\": %u,\n", SIM_CLOCK_HZ);
+#ifdef NDEBUG
+    fprintf(f, "    \"library_build_type\": \"release\"\n");
+#else
+    fprintf(f, "    \"library_build_type\": \"debug\"\n");
+#endif
+    fprintf(f, "  },\n  \"benchmarks\": [\n");
+
+    for (uint32_t id = 0; id < BENCH_COUNT; id++) {
+        const char *name = bench_table[id].name;
+        double      real[REPETITIONS_MAX], cpu[REPETITIONS_MAX], cyc[REPETITIONS_MAX];
+        char        agg_name[96];
+
+        if (!selected[id]) {
+            continue;
+        }
+        for (uint32_t k = 0; k < repetitions; k++) {
+            real[k] = runs[id][k].real_ns;
+            cpu[k]  = runs[id][k].cpu_ns;
+            cyc[k]  = runs[id][k].sim_cycles;
+            json_entry(f, &first, name, name, NULL, runs[id][k].iterations,
+                       real[k], cpu[k], cyc[k]);
+        }
+        if (repetitions < 2U) {
+            continue;
+        }
+        for (uint32_t a = 0; a < sizeof(aggregates) / sizeof(aggregates[0]); a++) {
+            snprintf(agg_name, sizeof(agg_name), "%s_%s", name, aggregates[a]);
+            json_entry(f, &first, agg_name, name, aggregates[a], repetitions,
+                       aggregate(aggregates[a], real, repetitions),
+                       aggregate(aggregates[a], cpu, repetitions),
+                       aggregate(aggregates[a], cyc, repetitions));
+        }
+    }
+    fprintf(f, "\n  ]\n}\n");
+    fclose(f);
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------
+//  bench_main
+//  Runs on the simulated board: bring up the drivers the kernels touch (main() steps 3..12
+//  without the interrupt sources), then time the table.
+//-------------------------------------------------------------------------------------------
+static void bench_main(void) {
+
+    Timebase_Init();
+    Trace_Init();
+    Board_Pins_Init();
+    TimerWheel_Init(0);
+    PWM_Init();
+    Arming_Init(ARMING_STATE_ARMED);
+
+    printf("%-24s %14s %14s %12s %12s\n", "Benchmark", "Time", "CPU", "Iterations",
+           "sim cyc/op");
+    for (uint32_t id = 0; id < BENCH_COUNT; id++) {
+        if (!selected[id]) {
+            continue;
+        }
+        bench_one(id);
+        for (uint32_t k = 0; k < repetitions; k++) {
+            const run_t *r = &runs[id][k];
+            printf("%-24s %11.1f ns %11.1f ns %12llu %12.1f\n", bench_table[id].name,
+                   r->real_ns, r->cpu_ns, (unsigned long long)r->iterations, r->sim_cycles);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (!strncmp(arg, "--benchmark_filter=", 19)) {
+            filter = arg + 19;
+        }
+        else if (!strncmp(arg, "--benchmark_min_time=", 21)) {
+            min_time = strtod(arg + 21, NULL);
+        }
+        else if (!strncmp(arg, "--benchmark_repetitions=", 24)) {
+            repetitions = (uint32_t)strtoul(arg + 24, NULL, 10);
+        }
+        else if (!strncmp(arg, "--benchmark_out=", 16)) {
+            out_path = arg + 16;
+        }
+        else {
+            fprintf(stderr, "usage: bench_host [--benchmark_filter=substr] "
+                            "[--benchmark_min_time=s] [--benchmark_repetitions=n] "
+                            "[--benchmark_out=results.json]\n");
+            return 2;
+        }
+    }
+    if (repetitions == 0U || repetitions > REPETITIONS_MAX || !(min_time > 0.0)) {
+        fprintf(stderr, "bench_host: repetitions 1..%u, min_time > 0\n", REPETITIONS_MAX);
+        return 2;
+    }
+    for (uint32_t id = 0; id < BENCH_COUNT; id++) {
+        selected[id] = strstr(bench_table[id].name, filter) != NULL;
+    }
+
+    Sim_Call(bench_main);
+
+    if (out_path && write_json(out_path) != 0) {
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * firmware_host.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ *
+ *  Runs the unmodified firmware (Src/) on the simulated STM32L476 (sim/) and prints
+ *  what it did. Default scenario, over the run time:
+ *    - PC0 throttle ramps from 0 V to 3.3 V
+ *    - PC13 button pressed at 2 s (ARMED -> DISARMED) and at 4 s (-> ARMING, ARMED 3 s
+ *      later)
+ *
+ *  Usage: firmware_host [seconds]          (default 10, any positive number)
+ */
+#include "sim.h"
+#include "arming.h"
+#include "power.h"
+#include "scheduler.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BUTTON_PIN      13U     // PC13, active low
+#define LED_PIN         5U      // PA5
+#define PRESS_MS        80U
+
+static uint64_t run_cycles;
+static uint32_t led_edges;
+static uint32_t pulse_min = UINT32_MAX;
+static uint32_t pulse_max = 0;
+
+static uint32_t throttle_mv(uint32_t channel, uint64_t cycles) {
+    (void)channel;
+    return (uint32_t)(cycles * SIM_VDDA_MV / run_cycles);
+}
+
+static void pwm_frame(const sim_frame_t *frame) {
+
+    uint32_t pulse_us = frame->high / (SIM_CLOCK_HZ / 1000000U);
+
+    if (pulse_us < pulse_min) pulse_min = pulse_us;
+    if (pulse_us > pulse_max) pulse_max = pulse_us;
+
+    // One line per simulated second (50 frames)
+    if ((frame->start / frame->period) % 50U == 0U) {
+        static const char *const names[ARMING_STATE_COUNT] = { "DISARMED", "ARMING", "ARMED" };
+        printf("  %6.2f s  pulse %4u us  %s\n", (double)frame->start / SIM_CLOCK_HZ, pulse_us,
+               names[ARMING_WORD_STATE(arming_state_word)]);
+    }
+}
+
+static void pin_changed(uint32_t port, uint32_t pin, uint32_t level, uint64_t cycles) {
+    (void)level;
+    (void)cycles;
+    if (port == SIM_PORT_A && pin == LED_PIN) {
+        led_edges++;
+    }
+}
+
+static void press(uint64_t at_ms) {
+    Sim_SchedulePin(SIM_PORT_C, BUTTON_PIN, 0, SIM_MS(at_ms));
+    Sim_SchedulePin(SIM_PORT_C, BUTTON_PIN, 1, SIM_MS(at_ms + PRESS_MS));
+}
+
+static int usage(void) {
+    fprintf(stderr, "usage: firmware_host [seconds]     simulated run time, > 0 (default 10)\n");
+    return 2;
+}
+
+int main(int argc, char **argv) {
+
+    double seconds = 10.0;
+    struct timespec t0, t1;
+
+    // 1. Scenario
+    if (argc > 2) {
+        return usage();
+    }
+    if (argc == 2) {
+        char *end;
+        seconds = strtod(argv[1], &end);
+        if (end == argv[1] || *end != '\0' || !(seconds > 0.0) || seconds > 1e6) {
+            return usage();
+        }
+    }
+    run_cycles = (uint64_t)(seconds * SIM_CLOCK_HZ);
+    Sim_SetAdcInput(throttle_mv);
+    Sim_OnPwmFrame(pwm_frame);
+    Sim_OnPin(pin_changed);
+    Sim_SchedulePin(SIM_PORT_C, BUTTON_PIN, 1, 0);     // released
+    press(2000);
+    press(4000);
+
+    // 2. Run
+    printf("firmware_host: %.2f s simulated\n", seconds);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int rc = Sim_Run(run_cycles);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double host_s = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) * 1e-9;
+
+    if (rc != 0) {
+        printf("firmware_main returned\n");
+        return 1;
+    }
+
+    // 3. Summary
+    if (sim_stats.pwm_frames > 0U) {
+        printf("\nPWM frames %u, pulse %u..%u us, ADC conversions %u, LED edges %u\n",
+               sim_stats.pwm_frames, pulse_min, pulse_max, sim_stats.adc_conversions, led_edges);
+    }
+    else {
+        printf("\nPWM frames 0, ADC conversions %u, LED edges %u\n",
+               sim_stats.adc_conversions, led_edges);
+    }
+    printf("Exceptions %llu, register accesses %llu, asleep %.1f %%\n",
+           (unsigned long long)sim_stats.exceptions, (unsigned long long)sim_stats.accesses,
+           100.0 * (double)sim_stats.sleep_cycles / (double)Sim_Cycles());
+    if (power_stats.wake_samples > 0U) {
+        printf("Sleep wake-up by SysTick: %u samples, %u..%u cycles (simulated: WFI wakes "
+               "at once)\n", power_stats.wake_samples, power_stats.wake_cycles_min,
+               power_stats.wake_cycles_max);
+    }
+
+    printf("\nTask          runs  overruns  skipped  late(ms)  exec(cycles)\n");
+    for (uint32_t i = 0; i < task_count; i++) {
+        printf("  %-10s %6u  %8u  %7u  %8u  %12u\n", task_table[i].name, task_stats[i].runs,
+               task_stats[i].overruns, task_stats[i].skipped, task_stats[i].max_lateness_ms,
+               task_stats[i].max_exec_cycles);
+    }
+
+    printf("\nHost time %.3f s: %.0fx real time, %.2f M register accesses/s\n", host_s,
+           seconds / host_s, (double)sim_stats.accesses / host_s * 1e-6);
+    return 0;
+}
@@ -0,0 +1,340 @@
+/*
+ * firmware_replay.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ *
+ *  Replays a target capture (trace.h) through the unmodified firmware on the simulated
+ *  STM32L476 and prints the resulting command sequence, one line per event:
+ *
+ *      <TIM5 time in us>  <event>  <value>
+ *
+ *  Inputs taken from the capture:
+ *    - ADC_SAMPLE records: the n-th conversion of the replay returns the n-th captured
+ *      sample, whatever its timing
+ *    - BUTTON_EDGE records: PC13 is driven to the recorded level at the recorded stamp
+ *      (a clean edge; the capture holds what the firmware acted on, not the bounce)
+ *  Output: every record of the replayed firmware's own trace (adc, button, state, pwm,
+ *  overrun) plus the pulse of each TIM2 frame. The same capture always gives the same
+ *  output, so two firmware versions can be compared with diff.
+ *
+ *  The replay starts from reset, so the capture must too: a UART stream (TRACE_UART = 1,
+ *  first session only) or a debugger dump taken before the ring wrapped. The captured PWM
+ *  commits are compared with the replayed ones; the exit status is 1 if they differ.
+ *
+ *  Usage: firmware_replay [-o out] capture.bin
+ */
+#include "sim.h"
+#include "trace.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BUTTON_PIN      13U             // PC13, active low
+#define RECORDS_MAX     (1U << 20)      // 8 MB of capture, ~2.5 h at 2 records per frame
+#define REPLAY_LAG      4U              // newest records may still be being written
+#define TAIL_CYCLES     SIM_MS(100)     // run on past the last captured record
+#define REPLAY_ID_FRAME TRACE_ID_COUNT  // output only: TIM2 frame, arg = pulse in us
+
+typedef struct {
+    uint32_t        count;
+    trace_record_t *records;
+} capture_t;
+
+static const char *const event_names[TRACE_ID_COUNT + 1U] = {
+    "lost", "button", "state", "adc", "pwm", "overrun", "frame"
+};
+
+static capture_t in;                    // from the target
+static capture_t out;                   // from the replay
+static uint32_t  samples_used;
+static uint32_t  drained;
+
+//-------------------------------------------------------------------------------------------
+//  Capture file: header, then records. A dump holds the whole ring (oldest at head), a
+//  UART stream holds records in order and a new header after every target reset.
+//-------------------------------------------------------------------------------------------
+static uint32_t le32(const uint8_t *p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint16_t le16(const uint8_t *p) {
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static double ms(uint32_t ts) {
+    return (double)ts * 1000.0 / SIM_CLOCK_HZ;
+}
+
+static int parse_header(const uint8_t *p, size_t left, trace_header_t *h) {
+
+    if (left < sizeof(trace_header_t)) {
+        return 0;
+    }
+    h->magic       = le32(p);
+    h->version     = le16(p + 4);
+    h->record_size = le16(p + 6);
+    h->capacity    = le32(p + 8);
+    h->clock_hz    = le32(p + 12);
+    h->head        = le32(p + 16);
+    h->lost        = le32(p + 20);
+    return h->magic == TRACE_MAGIC && h->version == TRACE_VERSION &&
+           h->record_size == sizeof(trace_record_t) && h->clock_hz != 0U;
+}
+
+static void capture_push(capture_t *c, const uint8_t *p) {
+
+    if (c->count < RECORDS_MAX) {
+        trace_record_t *r = &c->records[c->count++];
+        r->ts  = le32(p);
+        r->id  = le16(p + 4);
+        r->arg = le16(p + 6);
+    }
+}
+
+// Replay output, kept in time order: a record can be stamped after a later one when an
+// interrupt lands between its slot reservation and its TIM5 read
+static void output_push(uint32_t ts, uint16_t id, uint16_t arg) {
+
+    if (out.count == RECORDS_MAX) {
+        return;
+    }
+    uint32_t i = out.count++;
+    while (i > 0U && (int32_t)(out.records[i - 1U].ts - ts) > 0) {
+        out.records[i] = out.records[i - 1U];
+        i--;
+    }
+    out.records[i] = (trace_record_t){ ts, id, arg };
+}
+
+static int capture_load(const char *path) {
+
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    uint8_t *data = malloc((size_t)size + 1U);
+    size_t   len  = fread(data, 1, (size_t)size, f);
+    fclose(f);
+
+    // 1. A UART capture can start mid-record; skip to the first header
+    trace_header_t h;
+    size_t         off = 0;
+    while (off < len && !parse_header(&data[off], len - off, &h)) {
+        off++;
+    }
+    if (off == len) {
+        fprintf(stderr, "firmware_replay: no trace header in %s\n", path);
+        free(data);
+        return -1;
+    }
+    if (h.clock_hz != SIM_CLOCK_HZ) {
+        fprintf(stderr, "firmware_replay: capture stamped at %u Hz, simulator runs at %u Hz\n",
+                h.clock_hz, SIM_CLOCK_HZ);
+        free(data);
+        return -1;
+    }
+
+    in.records = calloc(RECORDS_MAX, sizeof(trace_record_t));
+
+    // 2. Debugger dump: usable only if nothing has been overwritten since reset
+    if (len - off == sizeof(trace_header_t) + (size_t)h.capacity * sizeof(trace_record_t)) {
+        if (h.head > h.capacity) {
+            fprintf(stderr, "firmware_replay: the ring wrapped (%u records), the dump does not "
+                            "reach back to reset\n", h.head);
+            free(data);
+            return -1;
+        }
+        for (uint32_t i = 0; i < h.head; i++) {
+            capture_push(&in, &data[off + sizeof(trace_header_t) + i * sizeof(trace_record_t)]);
+        }
+    }
+    // 3. UART stream: first session only
+    else {
+        trace_header_t next;
+        for (off += sizeof(trace_header_t); off + sizeof(trace_record_t) <= len;
+             off += sizeof(trace_record_t)) {
+            if (parse_header(&data[off], len - off, &next)) {
+                fprintf(stderr, "firmware_replay: target reset in the capture, replaying the "
+                                "first session only\n");
+                break;
+            }
+            capture_push(&in, &data[off]);
+        }
+    }
+    free(data);
+
+    for (uint32_t i = 0; i < in.count; i++) {
+        if (in.records[i].id == TRACE_ID_LOST) {
+            fprintf(stderr, "firmware_replay: %u records lost at %.3f ms, the replay diverges "
+                            "from there\n", in.records[i].arg, ms(in.records[i].ts));
+        }
+    }
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------
+//  Simulator hooks
+//-------------------------------------------------------------------------------------------
+
+// The n-th conversion returns the n-th captured sample (as a voltage that converts back
+// to the same code)
+static uint32_t captured_mv(uint32_t channel, uint64_t cycles) {
+
+    static uint16_t code = 0;
+
+    (void)channel;
+    (void)cycles;
+    while (samples_used < in.count) {
+        const trace_record_t *r = &in.records[samples_used++];
+        if (r->id == TRACE_ID_ADC_SAMPLE) {
+            code = r->arg;
+            break;
+        }
+    }
+    return (code * SIM_VDDA_MV + 511U) / 1023U;
+}
+
+static void replay_drain(void) {
+
+    uint32_t head = trace_buffer.header.head;
+
+    while (head - drained > REPLAY_LAG) {
+        const trace_record_t *r = &trace_buffer.records[drained++ & (TRACE_RECORDS - 1U)];
+        output_push(r->ts, r->id, r->arg);
+    }
+}
+
+static void pwm_frame(const sim_frame_t *frame) {
+
+    static int scheduled = 0;
+
+    // 1. First frame: TIM5 runs, so captured stamps map onto simulated time
+    if (!scheduled) {
+        uint64_t offset = frame->start - frame->timebase;
+
+        scheduled = 1;
+        for (uint32_t i = 0; i < in.count; i++) {
+            const trace_record_t *r = &in.records[i];
+            if (r->id == TRACE_ID_BUTTON_EDGE) {
+                uint64_t at = offset + r->ts;
+                Sim_SchedulePin(SIM_PORT_C, BUTTON_PIN, !r->arg,
+                                (at > frame->start) ? at : frame->start);
+            }
+        }
+    }
+
+    // 2. Replayed trace so far, and this frame
+    replay_drain();
+    output_push(frame->timebase, REPLAY_ID_FRAME,
+                (uint16_t)(frame->high / (SIM_CLOCK_HZ / 1000000U)));
+}
+
+//-------------------------------------------------------------------------------------------
+//  compare_commits
+//  Same PWM command values in the same order as on the target? Stamps are reported, not
+//  compared: the simulator is cycle-approximate.
+//-------------------------------------------------------------------------------------------
+static int compare_commits(void) {
+
+    uint32_t i = 0, j = 0, n = 0;
+    uint32_t worst = 0;
+
+    for (;;) {
+        while (i < in.count && in.records[i].id != TRACE_ID_PWM_COMMIT) i++;
+        while (j < out.count && out.records[j].id != TRACE_ID_PWM_COMMIT) j++;
+        if (i == in.count || j == out.count) {
+            break;
+        }
+        if (in.records[i].arg != out.records[j].arg) {
+            fprintf(stderr, "firmware_replay: commit %u differs: captured %u us at %.3f ms, "
+                            "replayed %u us at %.3f ms\n", n,
+                    in.records[i].arg, ms(in.records[i].ts),
+                    out.records[j].arg, ms(out.records[j].ts));
+            return 1;
+        }
+        uint32_t d = (uint32_t)abs((int32_t)(out.records[j].ts - in.records[i].ts));
+        if (d > worst) {
+            worst = d;
+        }
+        i++, j++, n++;
+    }
+
+    // The replay runs TAIL_CYCLES past the capture, so it may have a few more
+    while (i < in.count && in.records[i].id != TRACE_ID_PWM_COMMIT) i++;
+    if (i < in.count) {
+        fprintf(stderr, "firmware_replay: replay ended after %u of the captured commits\n", n);
+        return 1;
+    }
+    fprintf(stderr, "firmware_replay: %u commits match the capture (stamps within %.2f us)\n",
+            n, (double)worst * 1e6 / SIM_CLOCK_HZ);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+
+    const char *in_path  = NULL;
+    const char *out_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+            out_path = argv[++i];
+        }
+        else if (argv[i][0] != '-' && !in_path) {
+            in_path = argv[i];
+        }
+        else {
+            in_path = NULL;
+            break;
+        }
+    }
+    if (!in_path) {
+        fprintf(stderr, "usage: firmware_replay [-o out] capture.bin\n");
+        return 2;
+    }
+
+    // 1. Capture
+    if (capture_load(in_path) != 0) {
+        return 2;
+    }
+    if (in.count == 0U) {
+        fprintf(stderr, "firmware_replay: no records in %s\n", in_path);
+        return 2;
+    }
+    out.records = calloc(RECORDS_MAX, sizeof(trace_record_t));
+
+    // 2. Replay from reset up to the last captured record (TIM5 starts close to reset)
+    Sim_SetAdcInput(captured_mv);
+    Sim_OnPwmFrame(pwm_frame);
+    Sim_SchedulePin(SIM_PORT_C, BUTTON_PIN, 1, 0);     // released
+
+    if (Sim_Run(in.records[in.count - 1U].ts + TAIL_CYCLES) != 0) {
+        fprintf(stderr, "firmware_replay: firmware_main returned\n");
+        return 2;
+    }
+    replay_drain();
+
+    // 3. Command sequence
+    FILE *text = out_path ? fopen(out_path, "w") : stdout;
+    if (!text) {
+        perror(out_path);
+        return 2;
+    }
+    for (uint32_t i = 0; i < out.count; i++) {
+        const trace_record_t *r = &out.records[i];
+        fprintf(text, "%14.2f  %-7s %u\n", (double)r->ts * 1e6 / SIM_CLOCK_HZ,
+                (r->id <= REPLAY_ID_FRAME) ? event_names[r->id] : "id", r->arg);
+    }
+    if (text != stdout) {
+        fclose(text);
+    }
+
+    // 4. Same commands as the target?
+    return compare_commits();
+}
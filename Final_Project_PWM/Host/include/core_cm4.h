@@ -0,0 +1,156 @@
+/*
+ * core_cm4.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ *
+ *  Host replacement for CMSIS/Include/core_cm4.h, found first on the host include path.
+ *  Same type and bit names as CMSIS for the core registers the firmware uses; the
+ *  instances are register blocks in the simulator (sim/sim.c) and the intrinsics and
+ *  NVIC functions are simulator calls instead of inline assembly.
+ */
+
+#ifndef __STM32L476G_HOST_CORE_CM4_H
+#define __STM32L476G_HOST_CORE_CM4_H
+
+#include <stdint.h>
+
+// Read-only registers are not const here: the simulator publishes their values.
+#define __I      volatile
+#define __O      volatile
+#define __IO     volatile
+#define __IM     volatile
+#define __OM     volatile
+#define __IOM    volatile
+
+#define __STATIC_INLINE  static inline
+
+//-------------------------------------------------------------------------------------------
+//  Core register blocks (layout as in CMSIS core_cm4.h)
+//-------------------------------------------------------------------------------------------
+typedef struct {
+    __IM  uint32_t CPUID;
+    __IOM uint32_t ICSR;
+    __IOM uint32_t VTOR;
+    __IOM uint32_t AIRCR;
+    __IOM uint32_t SCR;
+    __IOM uint32_t CCR;
+    __IOM uint8_t  SHP[12U];
+    __IOM uint32_t SHCSR;
+    __IOM uint32_t CFSR;
+    __IOM uint32_t HFSR;
+    __IOM uint32_t DFSR;
+    __IOM uint32_t MMFAR;
+    __IOM uint32_t BFAR;
+    __IOM uint32_t AFSR;
+    __IM  uint32_t PFR[2U];
+    __IM  uint32_t DFR;
+    __IM  uint32_t ADR;
+    __IM  uint32_t MMFR[4U];
+    __IM  uint32_t ISAR[5U];
+          uint32_t RESERVED0[5U];
+    __IOM uint32_t CPACR;
+} SCB_Type;
+
+typedef struct {
+    __IOM uint32_t CTRL;
+    __IOM uint32_t LOAD;
+    __IOM uint32_t VAL;
+    __IM  uint32_t CALIB;
+} SysTick_Type;
+
+typedef struct {
+    __IOM uint32_t CTRL;
+    __IOM uint32_t CYCCNT;
+    __IOM uint32_t CPICNT;
+    __IOM uint32_t EXCCNT;
+    __IOM uint32_t SLEEPCNT;
+    __IOM uint32_t LSUCNT;
+    __IOM uint32_t FOLDCNT;
+    __IM  uint32_t PCSR;
+} DWT_Type;
+
+typedef struct {
+    __IOM uint32_t DHCSR;
+    __OM  uint32_t DCRSR;
+    __IOM uint32_t DCRDR;
+    __IOM uint32_t DEMCR;
+} CoreDebug_Type;
+
+typedef struct {
+    __IM  uint32_t TYPE;
+    __IOM uint32_t CTRL;
+    __IOM uint32_t RNR;
+    __IOM uint32_t RBAR;
+    __IOM uint32_t RASR;
+} MPU_Type;
+
+#define SCB_ICSR_PENDSTSET_Pos          26U
+#define SCB_ICSR_PENDSTSET_Msk          (1UL << SCB_ICSR_PENDSTSET_Pos)
+#define SCB_SCR_SLEEPDEEP_Pos           2U
+#define SCB_SCR_SLEEPDEEP_Msk           (1UL << SCB_SCR_SLEEPDEEP_Pos)
+#define SCB_SHCSR_MEMFAULTENA_Pos       16U
+#define SCB_SHCSR_MEMFAULTENA_Msk       (1UL << SCB_SHCSR_MEMFAULTENA_Pos)
+
+#define SysTick_CTRL_COUNTFLAG_Pos      16U
+#define SysTick_CTRL_COUNTFLAG_Msk      (1UL << SysTick_CTRL_COUNTFLAG_Pos)
+#define SysTick_CTRL_CLKSOURCE_Pos      2U
+#define SysTick_CTRL_CLKSOURCE_Msk      (1UL << SysTick_CTRL_CLKSOURCE_Pos)
+#define SysTick_CTRL_TICKINT_Pos        1U
+#define SysTick_CTRL_TICKINT_Msk        (1UL << SysTick_CTRL_TICKINT_Pos)
+#define SysTick_CTRL_ENABLE_Pos         0U
+#define SysTick_CTRL_ENABLE_Msk         (1UL << SysTick_CTRL_ENABLE_Pos)
+#define SysTick_LOAD_RELOAD_Msk         0xFFFFFFUL
+#define SysTick_VAL_CURRENT_Msk         0xFFFFFFUL
+
+#define DWT_CTRL_CYCCNTENA_Pos          0U
+#define DWT_CTRL_CYCCNTENA_Msk          (1UL << DWT_CTRL_CYCCNTENA_Pos)
+
+#define CoreDebug_DEMCR_TRCENA_Pos      24U
+#define CoreDebug_DEMCR_TRCENA_Msk      (1UL << CoreDebug_DEMCR_TRCENA_Pos)
+
+//-------------------------------------------------------------------------------------------
+//  Instances: every access goes through the simulator first (see stm32l476xx.h)
+//-------------------------------------------------------------------------------------------
+void *Sim_Access(volatile void *regs);
+
+extern SCB_Type       sim_scb;
+extern SysTick_Type   sim_systick;
+extern DWT_Type       sim_dwt;
+extern CoreDebug_Type sim_coredebug;
+extern MPU_Type       sim_mpu;
+
+#define SCB         ((SCB_Type *)Sim_Access(&sim_scb))
+#define SysTick     ((SysTick_Type *)Sim_Access(&sim_systick))
+#define DWT         ((DWT_Type *)Sim_Access(&sim_dwt))
+#define CoreDebug   ((CoreDebug_Type *)Sim_Access(&sim_coredebug))
+#define MPU         ((MPU_Type *)Sim_Access(&sim_mpu))
+
+//-------------------------------------------------------------------------------------------
+//  NVIC and intrinsics (sim/sim.c). IRQn_Type comes from stm32l476xx.h, which includes
+//  this file after its interrupt number enum.
+//-------------------------------------------------------------------------------------------
+void     NVIC_SetPriorityGrouping(uint32_t PriorityGroup);
+void     NVIC_EnableIRQ(IRQn_Type IRQn);
+void     NVIC_DisableIRQ(IRQn_Type IRQn);
+void     NVIC_SetPendingIRQ(IRQn_Type IRQn);
+void     NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+uint32_t NVIC_GetPendingIRQ(IRQn_Type IRQn);
+void     NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority);
+uint32_t NVIC_GetPriority(IRQn_Type IRQn);
+
+void     __disable_irq(void);
+void     __enable_irq(void);
+uint32_t __get_PRIMASK(void);
+void     __set_PRIMASK(uint32_t priMask);
+uint32_t __get_BASEPRI(void);
+void     __set_BASEPRI(uint32_t basePri);
+void     __set_BASEPRI_MAX(uint32_t basePri);
+uint32_t __get_MSP(void);
+void     __WFI(void);
+void     __DSB(void);
+void     __ISB(void);
+void     __DMB(void);
+void     __NOP(void);
+
+#endif /* __STM32L476G_HOST_CORE_CM4_H */
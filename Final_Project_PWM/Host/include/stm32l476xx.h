@@ -0,0 +1,76 @@
+/*
+ * stm32l476xx.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ *
+ *  Host build: this is the HAL seam. The drivers keep including "stm32l476xx.h" and
+ *  writing ADC1->CR, TIM2->CCR1, GPIOA->ODR ... unchanged. On the host this wrapper is
+ *  found first: it pulls in the real device header for the register layouts and bit
+ *  definitions, then points every peripheral the firmware uses at a register block in
+ *  the simulator. Sim_Access() brings the simulated hardware up to date before each
+ *  access (see sim/sim.h).
+ */
+
+#ifndef __STM32L476G_HOST_STM32L476XX_H
+#define __STM32L476G_HOST_STM32L476XX_H
+
+#include_next "stm32l476xx.h"
+
+extern RCC_TypeDef          sim_rcc;
+extern PWR_TypeDef          sim_pwr;
+extern FLASH_TypeDef        sim_flash;
+extern SYSCFG_TypeDef       sim_syscfg;
+extern EXTI_TypeDef         sim_exti;
+extern GPIO_TypeDef         sim_gpioa;
+extern GPIO_TypeDef         sim_gpioc;
+extern TIM_TypeDef          sim_tim2;
+extern TIM_TypeDef          sim_tim5;
+extern TIM_TypeDef          sim_tim6;
+extern ADC_TypeDef          sim_adc1;
+extern ADC_Common_TypeDef   sim_adc123_common;
+extern USART_TypeDef        sim_usart2;
+extern DMA_TypeDef          sim_dma1;
+extern DMA_Channel_TypeDef  sim_dma1_channel7;
+extern DMA_Request_TypeDef  sim_dma1_cselr;
+extern uint8_t              sim_flash_memory[];
+
+#undef RCC
+#undef PWR
+#undef FLASH
+#undef SYSCFG
+#undef EXTI
+#undef GPIOA
+#undef GPIOC
+#undef TIM2
+#undef TIM5
+#undef TIM6
+#undef ADC1
+#undef ADC123_COMMON
+#undef USART2
+#undef DMA1
+#undef DMA1_Channel7
+#undef DMA1_CSELR
+#undef FLASH_BASE
+
+#define RCC             ((RCC_TypeDef *)Sim_Access(&sim_rcc))
+#define PWR             ((PWR_TypeDef *)Sim_Access(&sim_pwr))
+#define FLASH           ((FLASH_TypeDef *)Sim_Access(&sim_flash))
+#define SYSCFG          ((SYSCFG_TypeDef *)Sim_Access(&sim_syscfg))
+#define EXTI            ((EXTI_TypeDef *)Sim_Access(&sim_exti))
+#define GPIOA           ((GPIO_TypeDef *)Sim_Access(&sim_gpioa))
+#define GPIOC           ((GPIO_TypeDef *)Sim_Access(&sim_gpioc))
+#define TIM2            ((TIM_TypeDef *)Sim_Access(&sim_tim2))
+#define TIM5            ((TIM_TypeDef *)Sim_Access(&sim_tim5))
+#define TIM6            ((TIM_TypeDef *)Sim_Access(&sim_tim6))
+#define ADC1            ((ADC_TypeDef *)Sim_Access(&sim_adc1))
+#define ADC123_COMMON   ((ADC_Common_TypeDef *)Sim_Access(&sim_adc123_common))
+#define USART2          ((USART_TypeDef *)Sim_Access(&sim_usart2))
+#define DMA1            ((DMA_TypeDef *)Sim_Access(&sim_dma1))
+#define DMA1_Channel7   ((DMA_Channel_TypeDef *)Sim_Access(&sim_dma1_channel7))
+#define DMA1_CSELR      ((DMA_Request_TypeDef *)Sim_Access(&sim_dma1_cselr))
+
+// Flash memory (the parameter store reads and programs it directly)
+#define FLASH_BASE      ((uintptr_t)sim_flash_memory)
+
+#endif /* __STM32L476G_HOST_STM32L476XX_H */
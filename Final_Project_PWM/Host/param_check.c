@@ -0,0 +1,205 @@
+/*
+ * param_check.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ *
+ *  Boot load of the flash parameter store (Src/param_store.c) from damaged images, on
+ *  the simulated board. Each case writes an image with Param_Set(), damages it the way
+ *  a reset during programming can, and checks what Param_Init() loads from it:
+ *    - torn record  : the CRC half of the newest record cut short
+ *    - ECC record   : the newest record reads with a double ECC error (NMI)
+ *    - ECC header   : the header of the newer page reads with an ECC error, so the
+ *                     older page must be used
+ *    - ECC only page: the header of the only page damaged: a blank store (defaults)
+ *  and that the store still takes new values afterwards (the next compaction erases the
+ *  damaged page). One more case damages a slot before it is programmed:
+ *    - failed append: the record does not read back, so Param_Set() must move the values
+ *                     to the other page rather than leave a hole in the lane One forked process per case: one simulated run per process.
+ *
+ *  Usage: param_check
+ *  Exit status 1 if a case fails.
+ */
+#include "sim.h"
+#include "param_store.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define DEFAULT_(name, def, min, max, step)     (def),
+
+static const uint32_t defaults[PARAM_COUNT] = { PARAM_TABLE(DEFAULT_) };
+
+static uint32_t failures;
+
+// Flash offset (from FLASH_BASE) of a lane slot or, with slot -1, of the page header
+static uint32_t record_offset(uint32_t page, uint32_t id, int32_t slot) {
+
+    uint32_t dword = (slot < 0) ? 0U : 1U + id * PARAM_LANE_SLOTS + (uint32_t)slot;
+    return PARAM_FLASH_OFFSET + page * PARAM_PAGE_SIZE + dword * 8U;
+}
+
+static void expect(const char *what, uint32_t got, uint32_t want) {
+
+    if (got != want) {
+        printf("    %s: %u, expected %u\n", what, got, want);
+        failures++;
+    }
+}
+
+// Power cycle: RAM back to its reset contents, then the boot load
+static void reboot(void) {
+
+    memcpy(param_shadow, defaults, sizeof(param_shadow));
+    memset(&param_stats, 0, sizeof(param_stats));
+    Param_Init();
+}
+
+static void set(uint32_t id, uint32_t value) {
+
+    if (!Param_Set(id, value)) {
+        printf("    Param_Set(%u, %u) failed\n", id, value);
+        failures++;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  Cases (page 0 is written first: the first Param_Set on a blank store compacts to it)
+//-------------------------------------------------------------------------------------------
+static void case_torn_record(void) {
+
+    reboot();
+    set(PARAM_PULSE_MIN_US, 1050);
+    set(PARAM_PULSE_MIN_US, 1060);                          // slot 1
+
+    uint32_t *hi = (uint32_t *)&sim_flash_memory[record_offset(0, PARAM_PULSE_MIN_US, 1) + 4U];
+    *hi &= 0x0000FFFFU;                                     // CRC half never programmed
+
+    reboot();
+    expect("pulse min", Param_Get(PARAM_PULSE_MIN_US), 1050);
+    expect("bad records", param_stats.bad_records, 1);
+    expect("ECC errors", param_stats.ecc_errors, 0);
+}
+
+static void case_ecc_record(void) {
+
+    reboot();
+    set(PARAM_PULSE_MIN_US, 1050);
+    set(PARAM_PULSE_MIN_US, 1060);
+    Sim_FlashEccError(record_offset(0, PARAM_PULSE_MIN_US, 1));
+
+    reboot();
+    expect("pulse min", Param_Get(PARAM_PULSE_MIN_US), 1050);
+    expect("bad records", param_stats.bad_records, 1);
+    expect("ECC errors seen", param_stats.ecc_errors != 0U, 1);
+
+    set(PARAM_PULSE_MIN_US, 1070);                          // after the damaged slot
+    reboot();
+    expect("pulse min after a new value", Param_Get(PARAM_PULSE_MIN_US), 1070);
+}
+
+static void case_ecc_header(void) {
+
+    uint32_t value = 1000;
+
+    // 1. Page 0 (generation 1) with a full lane, then page 1 (generation 2)
+    reboot();
+    for (uint32_t i = 0; i < PARAM_LANE_SLOTS; i++) {
+        set(PARAM_ARMING_TIME_MS, value++);
+    }
+    set(PARAM_ARMING_TIME_MS, value);
+    expect("generation", param_stats.generation, 2);
+
+    // 2. Newer header damaged: page 0 and its newest value
+    Sim_FlashEccError(record_offset(1, 0, -1));
+    reboot();
+    expect("generation, damaged page 1", param_stats.generation, 1);
+    expect("arming time", Param_Get(PARAM_ARMING_TIME_MS), value - 1U);
+    expect("ECC errors", param_stats.ecc_errors, 1);
+
+    // 3. The lane is full: the next value erases and rewrites page 1
+    set(PARAM_ARMING_TIME_MS, 3000);
+    reboot();
+    expect("generation after compaction", param_stats.generation, 2);
+    expect("arming time after compaction", Param_Get(PARAM_ARMING_TIME_MS), 3000);
+    expect("ECC errors after compaction", param_stats.ecc_errors, 0);
+}
+
+static void case_ecc_only_page(void) {
+
+    reboot();
+    set(PARAM_HEARTBEAT_MS, 1000);
+    set(PARAM_PULSE_MAX_US, 1900);
+    Sim_FlashEccError(record_offset(0, 0, -1));
+
+    reboot();
+    expect("generation, no valid page", param_stats.generation, 0);
+    for (uint32_t id = 0; id < PARAM_COUNT; id++) {
+        expect("default", Param_Get(id), defaults[id]);
+    }
+
+    set(PARAM_PULSE_MAX_US, 1950);                          // first write of a blank store
+    reboot();
+    expect("pulse max after a new value", Param_Get(PARAM_PULSE_MAX_US), 1950);
+}
+
+static void case_failed_append(void) {
+
+    reboot();
+    set(PARAM_PULSE_MIN_US, 1050);                          // page 0, generation 1
+    Sim_FlashEccError(record_offset(0, PARAM_PULSE_MIN_US, 1));
+
+    set(PARAM_PULSE_MIN_US, 1060);                          // slot 1 fails: page 1
+    expect("generation after the failed append", param_stats.generation, 2);
+    set(PARAM_PULSE_MIN_US, 1070);                          // page 1, slot 1
+
+    reboot();
+    expect("generation", param_stats.generation, 2);
+    expect("pulse min", Param_Get(PARAM_PULSE_MIN_US), 1070);
+    expect("bad records", param_stats.bad_records, 0);
+}
+
+static const struct {
+    const char *name;
+    void      (*run)(void);
+} cases[] = {
+    { "torn record",   case_torn_record   },
+    { "ECC record",    case_ecc_record    },
+    { "ECC header",    case_ecc_header    },
+    { "ECC only page", case_ecc_only_page },
+    { "failed append", case_failed_append },
+};
+
+int main(int argc, char **argv) {
+
+    uint32_t failed = 0;
+    uint32_t count  = sizeof(cases) / sizeof(cases[0]);
+
+    (void)argv;
+    if (argc != 1) {
+        fprintf(stderr, "usage: param_check\n");
+        return 2;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        int   status;
+        pid_t pid;
+
+        fflush(stdout);
+        pid = fork();
+        if (pid == 0) {
+            Sim_Call(cases[i].run);
+            fflush(stdout);
+            _exit(failures != 0U);
+        }
+        waitpid(pid, &status, 0);
+        int ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        printf("%-14s %s\n", cases[i].name, ok ? "ok" : "FAIL");
+        failed += !ok;
+    }
+    printf("%u of %u cases failed\n", failed, count);
+    return failed != 0U;
+}
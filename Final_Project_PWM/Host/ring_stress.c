@@ -0,0 +1,189 @@
+/*
+ * ring_stress.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ *
+ *  Two-thread stress test of the lock-free SPSC ring (Inc/ring_buffer.h): one producer
+ *  thread pushes a numbered stream of multi-word items as fast as it can, one consumer
+ *  thread takes them out, mixing name_pop() with name_peek_span() / name_consume() of a
+ *  random part of the span. Every item is checked:
+ *    - order   : sequence numbers arrive consecutively, none lost or repeated
+ *    - payload : the other words of the item match its sequence number (a slot read
+ *                before the producer's release store would not)
+ *  The ring is small (16 slots) so both sides wrap and meet the full and empty cases all
+ *  the time, and head/tail start just below 2^32 so the free-running indices overflow
+ *  during the run.
+ *
+ *  Usage: ring_stress [-n items] [-s start_index]     (default 10000000, 0xFFFFF000)
+ *  Exit status 1 on the first bad item.
+ */
+#include "ring_buffer.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define STRESS_SLOTS    16U
+
+typedef struct {
+    uint32_t seq;
+    uint32_t inverse;   // ~seq
+    uint32_t mixed;     // seq * golden ratio
+    uint32_t sum;       // of the three above
+} stress_item_t;
+
+RING_BUFFER_DEFINE(stress_ring, stress_item_t, STRESS_SLOTS)
+
+static stress_ring_t ring;
+static uint32_t      items = 10000000U;
+
+static uint64_t popped;         // items taken with name_pop()
+static uint64_t spans;          // name_peek_span() calls that returned items
+static uint64_t bad;            // items that failed a check
+static char     first_bad[128];
+
+static stress_item_t make_item(uint32_t seq) {
+
+    stress_item_t item = { seq, ~seq, seq * 0x9E3779B9U, 0 };
+
+    item.sum = item.seq + item.inverse + item.mixed;
+    return item;
+}
+
+//-------------------------------------------------------------------------------------------
+//  check
+//  Compare one received item with the one expected next; reports the first mismatch.
+//-------------------------------------------------------------------------------------------
+static int check(const stress_item_t *got, uint32_t expected) {
+
+    stress_item_t want = make_item(expected);
+
+    if (memcmp(got, &want, sizeof(want)) == 0) {
+        return 1;
+    }
+    if (bad++ == 0) {
+        snprintf(first_bad, sizeof(first_bad),
+                 "item %u: got seq %u inverse %08x mixed %08x sum %08x", expected, got->seq,
+                 got->inverse, got->mixed, got->sum);
+    }
+    return 0;
+}
+
+static void *producer(void *arg) {
+
+    (void)arg;
+    for (uint32_t seq = 0; seq < items; seq++) {
+        stress_item_t item = make_item(seq);
+        while (!stress_ring_push(&ring, item)) {
+            sched_yield();      // full: let the consumer run (single-CPU hosts)
+        }
+    }
+    return NULL;
+}
+
+//-------------------------------------------------------------------------------------------
+//  consumer
+//  A xorshift picks, item by item, between pop and a partial consume of the span.
+//-------------------------------------------------------------------------------------------
+static void *consumer(void *arg) {
+
+    uint32_t expected = 0;
+    uint32_t rnd      = 0x2545F491U;
+
+    (void)arg;
+    while (expected < items && bad == 0) {
+        rnd ^= rnd << 13;
+        rnd ^= rnd >> 17;
+        rnd ^= rnd << 5;
+
+        if (rnd & 1U) {
+            stress_item_t item;
+            if (stress_ring_pop(&ring, &item)) {
+                check(&item, expected++);
+                popped++;
+            }
+            else {
+                sched_yield();  // empty
+            }
+        }
+        else {
+            stress_item_t *first;
+            uint32_t       n = stress_ring_peek_span(&ring, &first);
+            if (n != 0U) {
+                n = 1U + (rnd >> 8) % n;        // consume 1..n of them
+                for (uint32_t i = 0; i < n; i++) {
+                    check(&first[i], expected++);
+                }
+                stress_ring_consume(&ring, n);
+                spans++;
+            }
+            else {
+                sched_yield();
+            }
+        }
+    }
+    return NULL;
+}
+
+static int usage(void) {
+    fprintf(stderr, "usage: ring_stress [-n items] [-s start_index]\n");
+    return 2;
+}
+
+int main(int argc, char **argv) {
+
+    uint32_t        start = 0xFFFFF000U;
+    pthread_t       threads[2];
+    struct timespec t0, t1;
+
+    for (int i = 1; i < argc; i++) {
+        char *end;
+        if (i + 1 >= argc) {
+            return usage();
+        }
+        if (!strcmp(argv[i], "-n"))      items = (uint32_t)strtoul(argv[++i], &end, 0);
+        else if (!strcmp(argv[i], "-s")) start = (uint32_t)strtoul(argv[++i], &end, 0);
+        else return usage();
+        if (*end != '\0' || end == argv[i]) {
+            return usage();
+        }
+    }
+
+    // 1. Empty ring with the indices about to overflow
+    ring.head = start;
+    ring.tail = start;
+
+    // 2. Run both sides
+    printf("ring_stress: %u items through %u slots, indices from 0x%08x\n", items,
+           STRESS_SLOTS, start);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if (pthread_create(&threads[1], NULL, consumer, NULL) != 0 ||
+        pthread_create(&threads[0], NULL, producer, NULL) != 0) {
+        perror("pthread_create");
+        return 2;
+    }
+    pthread_join(threads[1], NULL);
+    if (bad != 0) {
+        printf("FAIL: %s\n", first_bad);
+        return 1;       // the producer may be stuck on a full ring
+    }
+    pthread_join(threads[0], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double host_s = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) * 1e-9;
+
+    // 3. Summary: the ring must end empty, with the indices advanced by every item
+    printf("popped %llu, spans %llu, full %u, %.1f M items/s\n", (unsigned long long)popped,
+           (unsigned long long)spans, ring.dropped, (double)items / host_s * 1e-6);
+    if (ring.head != start + items || ring.tail != ring.head) {
+        printf("FAIL: head 0x%08x tail 0x%08x, expected 0x%08x\n", ring.head, ring.tail,
+               start + items);
+        return 1;
+    }
+    printf("OK: %u items in order%s\n", items,
+           (uint32_t)(start + items) < start ? ", indices wrapped past 2^32" : "");
+    return 0;
+}
@@ -0,0 +1,1376 @@
+/*
+ * sim.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+#include "sim.h"
+#include <setjmp.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#define SIM_NEVER       UINT64_MAX
+#define SIM_VECTORS     (16 + FPU_IRQn + 1)
+#define THREAD_PRIO     0x100       // below every configurable priority
+#define PRIO_SHIFT      (8U - __NVIC_PRIO_BITS)
+#define EXTSEL_NONE     0xFFU
+#define HOST_PAGE_MAX   65536U      // largest host page size: sim_flash_memory alignment
+
+// Register blocks seen by the firmware (include/stm32l476xx.h, include/core_cm4.h)
+RCC_TypeDef          sim_rcc;
+PWR_TypeDef          sim_pwr;
+FLASH_TypeDef        sim_flash;
+SYSCFG_TypeDef       sim_syscfg;
+EXTI_TypeDef         sim_exti;
+GPIO_TypeDef         sim_gpioa;
+GPIO_TypeDef         sim_gpioc;
+TIM_TypeDef          sim_tim2;
+TIM_TypeDef          sim_tim5;
+TIM_TypeDef          sim_tim6;
+ADC_TypeDef          sim_adc1;
+ADC_Common_TypeDef   sim_adc123_common;
+USART_TypeDef        sim_usart2;
+DMA_TypeDef          sim_dma1;
+DMA_Channel_TypeDef  sim_dma1_channel7;
+DMA_Request_TypeDef  sim_dma1_cselr;
+SCB_Type             sim_scb;
+SysTick_Type         sim_systick;
+DWT_Type             sim_dwt;
+CoreDebug_Type       sim_coredebug;
+MPU_Type             sim_mpu;
+
+// Flash memory as the firmware sees it at FLASH_BASE (include/stm32l476xx.h)
+uint8_t              sim_flash_memory[SIM_FLASH_SIZE] __attribute__((aligned(HOST_PAGE_MAX)));
+
+sim_stats_t sim_stats;
+
+//-------------------------------------------------------------------------------------------
+//  Peripheral models. Each keeps the values it last published to its register block,
+//  so a difference at the next access is a firmware write.
+//-------------------------------------------------------------------------------------------
+typedef struct {
+    TIM_TypeDef *regs;
+    IRQn_Type    irq;
+    uint32_t     max;               // counter width: 0xFFFF or 0xFFFFFFFF
+    uint8_t      extsel;            // ADC regular trigger number of TRGO
+    uint8_t      pwm;               // report CH1 frames to the PWM hook
+    uint8_t      line;              // UIF & UIE
+    uint32_t     cr1, cnt, psc, arr, ccr1, sr, dier;    // published
+    uint32_t     psc_act, arr_act, ccr1_act;            // loaded at the update event
+    uint64_t     base;              // time at which the counter held base_cnt
+    uint32_t     base_cnt;
+    uint64_t     next_update;
+} sim_timer_t;
+
+typedef struct {
+    GPIO_TypeDef *regs;
+    uint32_t      exti_port;        // SYSCFG_EXTICR code (A = 0, C = 2)
+    uint32_t      odr, idr;         // published
+    uint32_t      moder, pupdr;     // configuration idr was computed from
+    uint32_t      ext_driven;       // pins driven from outside (Sim_SchedulePin)
+    uint32_t      ext_level;
+} sim_gpio_t;
+
+typedef struct {
+    uint64_t at;
+    uint8_t  port, pin, level;
+} sim_pin_event_t;
+
+static sim_timer_t tim2, tim5, tim6;
+static sim_gpio_t  gpio[SIM_PORT_COUNT];
+
+static struct {
+    uint32_t cr, isr, cfgr, ier, dr;
+    uint8_t  line;
+    uint64_t cal_end, ready_at, conv_end;
+} adc;
+
+static struct {
+    uint32_t pr;
+    uint8_t  line[7];               // EXTI0..4, EXTI9_5, EXTI15_10
+} exti;
+
+static struct {
+    uint32_t ctrl, load, val;
+    uint64_t next_wrap;
+} systick;
+
+static struct {
+    uint32_t ctrl, demcr, cyccnt;
+    uint32_t count;                 // CYCCNT at 'base' (awake time)
+    uint64_t base;
+} dwt;
+
+static struct {
+    uint32_t ccr, isr;
+    uint8_t  line;
+    uint64_t done;
+} dma7;
+
+static struct {
+    uint32_t cr, keyr, eccr;        // published
+    uint8_t  key_stage;             // KEY1 seen, KEY2 unlocks
+    uint8_t  blank;                 // memory erased once per process, kept across resets
+    uint64_t busy_until;
+} flash;
+
+// Double words with a double ECC error (Sim_FlashEccError). Reads are not seen, so the
+// host pages holding them are made inaccessible: the first access faults (SIGSEGV),
+// the fault handler raises the NMI if it is one of them and opens the pages until the
+// next sync.
+static struct {
+    uint32_t offset[SIM_FLASH_ECC_MAX];
+    uint32_t count;
+    uint8_t  open;                  // pages opened by an access, guarded again at sync
+    uintptr_t page;                 // host page size
+    struct sigaction prev;
+} ecc;
+
+static struct {
+    int16_t  prio[SIM_VECTORS];
+    uint8_t  enabled[SIM_VECTORS];
+    uint8_t  pending[SIM_VECTORS];
+    uint32_t pending_count;
+    int16_t  active[SIM_VECTORS];   // priorities of the handlers being run (nesting)
+    uint32_t depth;
+    uint32_t primask, basepri;
+} nvic;
+
+static struct {
+    uint64_t cycles;                // simulated time
+    uint64_t synced;                // time of the last publish
+    uint64_t stop_at;
+    jmp_buf  stop;
+    uint8_t  woke;                  // a handler ran since WFI was entered
+} sim;
+
+static sim_pin_event_t pin_events[SIM_PIN_EVENTS];
+static uint32_t        pin_event_head  = 0;
+static uint32_t        pin_event_count = 0;
+
+static sim_adc_input_t adc_input = NULL;
+static sim_pwm_hook_t  pwm_hook  = NULL;
+static sim_pin_hook_t  pin_hook  = NULL;
+
+//-------------------------------------------------------------------------------------------
+//  Vector table. Handlers the firmware does not define fall back to these, like the weak
+//  aliases to Default_Handler in the startup file.
+//-------------------------------------------------------------------------------------------
+static void sim_unhandled(const char *name) {
+    fprintf(stderr, "sim: unhandled exception %s at cycle %llu\n",
+            name, (unsigned long long)sim.cycles);
+    abort();
+}
+
+#define SIM_DEFAULT_HANDLER(name) \
+    __attribute__((weak)) void name(void) { sim_unhandled(#name); }
+
+SIM_DEFAULT_HANDLER(NMI_Handler)
+SIM_DEFAULT_HANDLER(HardFault_Handler)
+SIM_DEFAULT_HANDLER(MemManage_Handler)
+SIM_DEFAULT_HANDLER(SysTick_Handler)
+SIM_DEFAULT_HANDLER(ADC1_2_IRQHandler)
+SIM_DEFAULT_HANDLER(TIM2_IRQHandler)
+SIM_DEFAULT_HANDLER(EXTI0_IRQHandler)
+SIM_DEFAULT_HANDLER(EXTI1_IRQHandler)
+SIM_DEFAULT_HANDLER(EXTI2_IRQHandler)
+SIM_DEFAULT_HANDLER(EXTI3_IRQHandler)
+SIM_DEFAULT_HANDLER(EXTI4_IRQHandler)
+SIM_DEFAULT_HANDLER(EXTI9_5_IRQHandler)
+SIM_DEFAULT_HANDLER(EXTI15_10_IRQHandler)
+SIM_DEFAULT_HANDLER(TIM5_IRQHandler)
+SIM_DEFAULT_HANDLER(TIM6_DACUNDER_IRQHandler)
+SIM_DEFAULT_HANDLER(DMA1_Channel7_IRQHandler)
+SIM_DEFAULT_HANDLER(USART2_IRQHandler)
+
+static void (*const vectors[SIM_VECTORS])(void) = {
+    [16 + NonMaskableInt_IRQn]   = NMI_Handler,
+    [16 + HardFault_IRQn]        = HardFault_Handler,
+    [16 + MemoryManagement_IRQn] = MemManage_Handler,
+    [16 + SysTick_IRQn]          = SysTick_Handler,
+    [16 + EXTI0_IRQn]            = EXTI0_IRQHandler,
+    [16 + EXTI1_IRQn]            = EXTI1_IRQHandler,
+    [16 + EXTI2_IRQn]            = EXTI2_IRQHandler,
+    [16 + EXTI3_IRQn]            = EXTI3_IRQHandler,
+    [16 + EXTI4_IRQn]            = EXTI4_IRQHandler,
+    [16 + DMA1_Channel7_IRQn]    = DMA1_Channel7_IRQHandler,
+    [16 + ADC1_2_IRQn]           = ADC1_2_IRQHandler,
+    [16 + EXTI9_5_IRQn]          = EXTI9_5_IRQHandler,
+    [16 + TIM2_IRQn]             = TIM2_IRQHandler,
+    [16 + USART2_IRQn]           = USART2_IRQHandler,
+    [16 + EXTI15_10_IRQn]        = EXTI15_10_IRQHandler,
+    [16 + TIM5_IRQn]             = TIM5_IRQHandler,
+    [16 + TIM6_DAC_IRQn]         = TIM6_DACUNDER_IRQHandler,
+};
+
+// EXTI lines behind each EXTI interrupt, in the order of exti.line[]
+static const struct {
+    IRQn_Type irq;
+    uint32_t  lines;
+} exti_irqs[7] = {
+    { EXTI0_IRQn,     0x0001U },
+    { EXTI1_IRQn,     0x0002U },
+    { EXTI2_IRQn,     0x0004U },
+    { EXTI3_IRQn,     0x0008U },
+    { EXTI4_IRQn,     0x0010U },
+    { EXTI9_5_IRQn,   0x03E0U },
+    { EXTI15_10_IRQn, 0xFC00U },
+};
+
+//-------------------------------------------------------------------------------------------
+//  NVIC
+//-------------------------------------------------------------------------------------------
+static void nvic_pend(IRQn_Type irq) {
+
+    uint32_t v = (uint32_t)(irq + 16);
+
+    if (!nvic.pending[v]) {
+        nvic.pending[v] = 1;
+        nvic.pending_count++;
+    }
+}
+
+// Pend an interrupt on the rising edge of its request line
+static void irq_line(uint8_t *line, uint32_t level, IRQn_Type irq) {
+
+    if (level && !*line) {
+        nvic_pend(irq);
+    }
+    *line = (level != 0);
+}
+
+static int nvic_can_preempt(uint32_t v) {
+
+    int32_t exec = nvic.depth ? nvic.active[nvic.depth - 1] : THREAD_PRIO;
+    int32_t prio = nvic.prio[v];
+
+    if (!nvic.pending[v] || !nvic.enabled[v] || prio >= exec) {
+        return 0;
+    }
+    return prio < 0 || nvic.basepri == 0 || prio < (int32_t)nvic.basepri;
+}
+
+// Highest-priority interrupt that could run now, ignoring PRIMASK; -1 if none
+static int nvic_next(void) {
+
+    int best = -1;
+
+    if (nvic.pending_count == 0) {
+        return -1;
+    }
+    for (uint32_t v = 0; v < SIM_VECTORS; v++) {
+        if (nvic_can_preempt(v) && (best < 0 || nvic.prio[v] < nvic.prio[best])) {
+            best = (int)v;
+        }
+    }
+    return best;
+}
+
+static void exti_handled(uint32_t v);
+static void adc_handled(uint32_t v);
+
+// Run one handler (and everything that preempts it). Returns 0 if nothing was taken.
+// PRIMASK masks everything but the NMI and HardFault.
+static int nvic_take(void) {
+
+    int v = nvic_next();
+    if (v < 0 || (nvic.primask && nvic.prio[v] >= 0)) {
+        return 0;
+    }
+
+    // 1. Entry: clear pending, raise the execution priority
+    nvic.pending[v] = 0;
+    nvic.pending_count--;
+    nvic.active[nvic.depth++] = nvic.prio[v];
+    sim.cycles += SIM_EXC_ENTRY_CYCLES;
+    sim.woke = 1;
+    sim_stats.exceptions++;
+
+    // 2. Handler
+    if (vectors[v] != NULL) {
+        vectors[v]();
+    }
+    else {
+        sim_unhandled("(no vector)");
+    }
+
+    // 3. Return
+    sim.cycles += SIM_EXC_EXIT_CYCLES;
+    nvic.depth--;
+    exti_handled((uint32_t)v);
+    adc_handled((uint32_t)v);
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------
+//  ADC1 (single channel regular sequence, single conversion mode)
+//-------------------------------------------------------------------------------------------
+static uint32_t adc_clock_div(void) {
+
+    static const uint32_t div[4] = { 1U, 1U, 2U, 4U };  // CKMODE 00 (async) taken as HCLK/1
+    return div[(sim_adc123_common.CCR & ADC_CCR_CKMODE) >> ADC_CCR_CKMODE_Pos];
+}
+
+static uint32_t adc_channel(void) {
+    return (sim_adc1.SQR1 & ADC_SQR1_SQ1) >> ADC_SQR1_SQ1_Pos;
+}
+
+static uint32_t adc_bits(void) {
+    return 12U - 2U * ((adc.cfgr & ADC_CFGR_RES) >> ADC_CFGR_RES_Pos);
+}
+
+// Sampling time (SMPR) + successive approximation (RES), in half ADC clock cycles
+static uint64_t adc_conversion_cycles(void) {
+
+    static const uint32_t smp_half[8] = { 5, 13, 25, 49, 95, 185, 495, 1281 };
+    uint32_t ch  = adc_channel();
+    uint32_t smp = (ch < 10U) ? (sim_adc1.SMPR1 >> (3U * ch)) & 7U
+                              : (sim_adc1.SMPR2 >> (3U * (ch - 10U))) & 7U;
+    uint32_t half = smp_half[smp] + 2U * adc_bits() + 1U;
+
+    return (uint64_t)((half + 1U) / 2U) * adc_clock_div();
+}
+
+static void adc_start(uint64_t t) {
+
+    adc.isr     &= ~(ADC_ISR_EOC | ADC_ISR_EOS);
+    adc.conv_end = t + adc_conversion_cycles();
+}
+
+static void adc_end(uint64_t t) {
+
+    uint32_t bits = adc_bits();
+    uint32_t full = (1U << bits) - 1U;
+    uint32_t mv   = adc_input ? adc_input(adc_channel(), t) : 0U;
+    uint32_t code = (uint32_t)(((uint64_t)mv * full + SIM_VDDA_MV / 2U) / SIM_VDDA_MV);
+
+    if (code > full) {
+        code = full;
+    }
+    if (adc.cfgr & ADC_CFGR_ALIGN) {
+        code <<= 16U - bits;
+    }
+
+    adc.dr       = code;
+    adc.isr     |= ADC_ISR_EOC | ADC_ISR_EOS;
+    adc.conv_end = SIM_NEVER;
+    if ((adc.cfgr & ADC_CFGR_EXTEN) == 0) {
+        adc.cr &= ~ADC_CR_ADSTART;          // software start: one sequence, then stop
+    }
+    sim_stats.adc_conversions++;
+}
+
+// See sim.h: EOC/EOS are cleared when the ADC handler returns (it has read DR). Only
+// those bits change in the register block, so a pending firmware write is still seen.
+static void adc_handled(uint32_t v) {
+
+    if (v == (uint32_t)(ADC1_2_IRQn + 16)) {
+        adc.isr       &= ~(ADC_ISR_EOC | ADC_ISR_EOS);
+        sim_adc1.ISR  &= ~(ADC_ISR_EOC | ADC_ISR_EOS);
+        irq_line(&adc.line, adc.isr & adc.ier & 0x7FFU, ADC1_2_IRQn);
+    }
+}
+
+// Timer TRGO edge: start a conversion if the regular group waits for this trigger
+static void adc_trigger(uint8_t extsel, uint64_t t) {
+
+    if ((adc.cr & (ADC_CR_ADEN | ADC_CR_ADSTART)) == (ADC_CR_ADEN | ADC_CR_ADSTART) &&
+        (adc.cfgr & ADC_CFGR_EXTEN) != 0 &&
+        ((adc.cfgr & ADC_CFGR_EXTSEL) >> ADC_CFGR_EXTSEL_Pos) == extsel &&
+        adc.conv_end == SIM_NEVER) {
+        adc_start(t);
+    }
+}
+
+static void adc_writes(uint64_t now) {
+
+    ADC_TypeDef *r = &sim_adc1;
+
+    adc.cfgr = r->CFGR;
+    adc.ier  = r->IER;
+
+    // ISR: write 1 to clear
+    if (r->ISR != adc.isr) {
+        adc.isr &= ~r->ISR;
+    }
+
+    if (r->CR != adc.cr) {
+        uint32_t set = r->CR & ~adc.cr;
+        adc.cr = r->CR;
+
+        if (set & ADC_CR_ADCAL) {
+            adc.cal_end = now + (uint64_t)SIM_ADC_CAL_CYCLES * adc_clock_div();
+        }
+        if (set & ADC_CR_ADEN) {
+            adc.ready_at = now + adc_clock_div();
+        }
+        if (adc.cr & ADC_CR_ADDIS) {
+            adc.cr      &= ~(ADC_CR_ADEN | ADC_CR_ADDIS | ADC_CR_ADSTART);
+            adc.isr     &= ~ADC_ISR_ADRDY;
+            adc.conv_end = SIM_NEVER;
+        }
+        if (adc.cr & ADC_CR_ADSTP) {
+            adc.cr      &= ~(ADC_CR_ADSTP | ADC_CR_ADSTART);
+            adc.conv_end = SIM_NEVER;
+        }
+        if (set & ADC_CR_ADSTART) {
+            if (!(adc.cr & ADC_CR_ADEN)) {
+                adc.cr &= ~ADC_CR_ADSTART;
+            }
+            else if ((adc.cfgr & ADC_CFGR_EXTEN) == 0) {
+                adc_start(now);
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  General-purpose / basic timers (up-counting, CH1 PWM output on TIM2)
+//-------------------------------------------------------------------------------------------
+static uint32_t timer_count(const sim_timer_t *t, uint64_t now) {
+
+    if (!(t->cr1 & TIM_CR1_CEN)) {
+        return t->cnt;
+    }
+    if (t->psc_act == 0U) {
+        return t->base_cnt + (uint32_t)(now - t->base);     // TIM5: read on every trace stamp
+    }
+    return t->base_cnt + (uint32_t)((now - t->base) / ((uint64_t)t->psc_act + 1U));
+}
+
+static void timer_schedule(sim_timer_t *t) {
+
+    if (!(t->cr1 & TIM_CR1_CEN)) {
+        t->next_update = SIM_NEVER;
+        return;
+    }
+    uint64_t top = (t->base_cnt <= t->arr_act) ? t->arr_act : t->max;
+    t->next_update = t->base + (top + 1U - t->base_cnt) * ((uint64_t)t->psc_act + 1U);
+}
+
+static void timer_line(sim_timer_t *t) {
+    irq_line(&t->line, (t->sr & TIM_SR_UIF) && (t->dier & TIM_DIER_UIE), t->irq);
+}
+
+// CH1 output of the frame starting now (PWM mode 1/2, polarity)
+static void timer_frame(sim_timer_t *t, uint64_t at) {
+
+    sim_frame_t frame = { at, timer_count(&tim5, at), 0, 0 };
+    uint32_t    mode  = ((t->regs->CCMR1 & TIM_CCMR1_OC1M) >> TIM_CCMR1_OC1M_Pos) & 7U;
+
+    frame.period = (t->arr_act + 1U) * (t->psc_act + 1U);
+    if ((t->regs->CCER & TIM_CCER_CC1E) && (mode == 6U || mode == 7U)) {
+        uint32_t counts = (t->ccr1_act <= t->arr_act) ? t->ccr1_act : t->arr_act + 1U;
+        frame.high = counts * (t->psc_act + 1U);
+        if (mode == 7U) {
+            frame.high = frame.period - frame.high;
+        }
+        if (t->regs->CCER & TIM_CCER_CC1P) {
+            frame.high = frame.period - frame.high;
+        }
+    }
+
+    sim_stats.pwm_frames++;
+    if (pwm_hook) {
+        pwm_hook(&frame);
+    }
+}
+
+// Update event: overflow (software = 0) or UG (software = 1)
+static void timer_update(sim_timer_t *t, uint64_t at, uint8_t software) {
+
+    // 1. Preloaded registers take effect, counter restarts from 0
+    t->psc_act  = t->psc;
+    t->arr_act  = t->arr;
+    t->ccr1_act = t->ccr1;
+    t->base     = at;
+    t->base_cnt = 0;
+    t->cnt      = 0;
+
+    // 2. Flags, one-pulse stop, trigger output (MMS = 010: update)
+    if (!(software && (t->cr1 & TIM_CR1_URS))) {
+        t->sr |= TIM_SR_UIF;
+    }
+    if (!software && (t->cr1 & TIM_CR1_OPM)) {
+        t->cr1 &= ~TIM_CR1_CEN;
+    }
+    if (t->extsel != EXTSEL_NONE && (t->regs->CR2 & TIM_CR2_MMS) == TIM_CR2_MMS_1) {
+        adc_trigger(t->extsel, at);
+    }
+
+    timer_schedule(t);
+    timer_line(t);
+
+    // 3. New frame on the PWM output
+    if (t->pwm && !software) {
+        timer_frame(t, at);
+    }
+}
+
+static void timer_writes(sim_timer_t *t, uint64_t now) {
+
+    TIM_TypeDef *r = t->regs;
+
+    // 1. Counter (before CR1, which may freeze it)
+    if (r->CNT != t->cnt) {
+        t->cnt      = r->CNT;
+        t->base_cnt = r->CNT;
+        t->base     = now;
+        timer_schedule(t);
+    }
+
+    // 2. Start / stop
+    if (r->CR1 != t->cr1) {
+        uint32_t was = t->cr1;
+        if (was & TIM_CR1_CEN) {
+            t->cnt = timer_count(t, now);
+        }
+        t->cr1 = r->CR1;
+        if ((t->cr1 & TIM_CR1_CEN) && !(was & TIM_CR1_CEN)) {
+            t->base_cnt = t->cnt;
+            t->base     = now;
+        }
+        timer_schedule(t);
+    }
+
+    // 3. Preloads
+    t->psc = r->PSC;
+    if (r->ARR != t->arr) {
+        t->arr = r->ARR;
+        if (!(t->cr1 & TIM_CR1_ARPE)) {
+            t->base_cnt = timer_count(t, now);
+            t->base     = now;
+            t->arr_act  = t->arr;
+            timer_schedule(t);
+        }
+    }
+    if (r->CCR1 != t->ccr1) {
+        t->ccr1 = r->CCR1;
+        if (!(r->CCMR1 & TIM_CCMR1_OC1PE)) {
+            t->ccr1_act = t->ccr1;
+        }
+    }
+
+    // 4. Software update, status (rc_w0), interrupt enable
+    if (r->EGR & TIM_EGR_UG) {
+        timer_update(t, now, 1);
+    }
+    r->EGR = 0;
+    if (r->SR != t->sr) {
+        t->sr &= r->SR;
+    }
+    t->dier = r->DIER;
+    timer_line(t);
+}
+
+static void timer_publish(sim_timer_t *t, uint64_t now) {
+
+    TIM_TypeDef *r = t->regs;
+
+    t->cnt  = timer_count(t, now);
+    r->CNT  = t->cnt;
+    r->CR1  = t->cr1;
+    r->SR   = t->sr;
+    r->ARR  = t->arr;
+    r->CCR1 = t->ccr1;
+}
+
+//-------------------------------------------------------------------------------------------
+//  GPIO + EXTI
+//-------------------------------------------------------------------------------------------
+static void exti_line_update(void) {
+
+    uint32_t active = exti.pr & sim_exti.IMR1;
+
+    for (uint32_t i = 0; i < 7U; i++) {
+        irq_line(&exti.line[i], active & exti_irqs[i].lines, exti_irqs[i].irq);
+    }
+}
+
+static void exti_edge(uint32_t exti_port, uint32_t pin, uint32_t level) {
+
+    uint32_t bit = 1UL << pin;
+
+    if (((sim_syscfg.EXTICR[pin / 4U] >> (4U * (pin % 4U))) & 0xFU) != exti_port) {
+        return;
+    }
+    if (((level ? sim_exti.RTSR1 : sim_exti.FTSR1) & bit) && (sim_exti.IMR1 & bit)) {
+        exti.pr |= bit;
+    }
+}
+
+// See sim.h: PR is cleared when the handler of its lines returns
+static void exti_handled(uint32_t v) {
+
+    for (uint32_t i = 0; i < 7U; i++) {
+        if ((uint32_t)(exti_irqs[i].irq + 16) == v) {
+            exti.pr &= ~exti_irqs[i].lines;
+            exti_line_update();
+        }
+    }
+}
+
+static void exti_writes(void) {
+
+    if (sim_exti.PR1 != exti.pr) {
+        exti.pr &= ~sim_exti.PR1;           // write 1 to clear
+    }
+    if (sim_exti.SWIER1 != 0) {
+        exti.pr |= sim_exti.SWIER1 & sim_exti.IMR1;
+        sim_exti.SWIER1 = 0;
+    }
+    exti_line_update();
+}
+
+// Pins whose 2-bit MODER / PUPDR field equals 'value', as a 16-bit mask
+static uint32_t gpio_field_mask(uint32_t reg, uint32_t value) {
+
+    uint32_t x = reg ^ (value * 0x55555555U);
+    uint32_t m = ~(x | (x >> 1)) & 0x55555555U;     // bit 2n set: field n matches
+
+    m = (m | (m >> 1)) & 0x33333333U;
+    m = (m | (m >> 2)) & 0x0F0F0F0FU;
+    m = (m | (m >> 4)) & 0x00FF00FFU;
+    m = (m | (m >> 8)) & 0x0000FFFFU;
+    return m;
+}
+
+// Input data register from the pin configuration, output latch and outside drivers
+// (runs on every access: all 16 pins at once)
+static uint32_t gpio_levels(const sim_gpio_t *g) {
+
+    uint32_t output = gpio_field_mask(g->regs->MODER, 1U);
+    uint32_t pullup = gpio_field_mask(g->regs->MODER, 0U) & gpio_field_mask(g->regs->PUPDR, 1U);
+    uint32_t driven = g->ext_driven & ~output;
+
+    return (g->odr & output) | (g->ext_level & driven) | (pullup & ~g->ext_driven);
+}
+
+static void gpio_refresh(sim_gpio_t *g, uint32_t port, uint64_t now) {
+
+    uint32_t idr     = gpio_levels(g);
+    uint32_t changed = idr ^ g->idr;
+
+    g->idr   = idr;
+    g->moder = g->regs->MODER;
+    g->pupdr = g->regs->PUPDR;
+    for (uint32_t pin = 0; changed != 0U; pin++, changed >>= 1) {
+        if (changed & 1U) {
+            uint32_t level = (idr >> pin) & 1U;
+            exti_edge(g->exti_port, pin, level);
+            if (pin_hook && ((g->regs->MODER >> (2U * pin)) & 3U) == 1U) {
+                pin_hook(port, pin, level, now);
+            }
+        }
+    }
+}
+
+// Returns 1 if the pin levels need to be recomputed
+static uint32_t gpio_writes(sim_gpio_t *g) {
+
+    GPIO_TypeDef *r   = g->regs;
+    uint32_t      odr = g->odr;
+
+    if (r->ODR != g->odr) {
+        g->odr = r->ODR & 0xFFFFU;
+    }
+    if (r->BSRR != 0) {
+        g->odr = (g->odr & ~(r->BSRR >> 16)) | (r->BSRR & 0xFFFFU);
+        r->BSRR = 0;
+    }
+    if (r->BRR != 0) {
+        g->odr &= ~r->BRR;
+        r->BRR = 0;
+    }
+    return g->odr != odr || r->MODER != g->moder || r->PUPDR != g->pupdr;
+}
+
+//-------------------------------------------------------------------------------------------
+//  SysTick, DWT, DMA1 channel 7
+//-------------------------------------------------------------------------------------------
+static uint64_t systick_scale(void) {
+    return (systick.ctrl & SysTick_CTRL_CLKSOURCE_Msk) ? 1U : 8U;
+}
+
+static uint32_t systick_value(uint64_t now) {
+
+    if (systick.next_wrap == SIM_NEVER) {
+        return systick.val;
+    }
+    return (uint32_t)((systick.next_wrap - now) / systick_scale());
+}
+
+static void systick_writes(uint64_t now) {
+
+    SysTick_Type *r = &sim_systick;
+    uint32_t ctrl_bits = SysTick_CTRL_ENABLE_Msk | SysTick_CTRL_TICKINT_Msk |
+                         SysTick_CTRL_CLKSOURCE_Msk;
+
+    systick.load = r->LOAD & SysTick_LOAD_RELOAD_Msk;
+
+    // 1. Any write to VAL clears it and COUNTFLAG; the next clock reloads
+    if (r->VAL != systick.val) {
+        systick.val   = 0;
+        systick.ctrl &= ~SysTick_CTRL_COUNTFLAG_Msk;
+        if (systick.next_wrap != SIM_NEVER) {
+            systick.next_wrap = now + ((uint64_t)systick.load + 1U) * systick_scale();
+        }
+    }
+
+    // 2. Enable / disable
+    if ((r->CTRL & ctrl_bits) != (systick.ctrl & ctrl_bits)) {
+        uint32_t was = systick.ctrl;
+        systick.val  = systick_value(now);
+        systick.ctrl = (systick.ctrl & SysTick_CTRL_COUNTFLAG_Msk) | (r->CTRL & ctrl_bits);
+
+        if (!(systick.ctrl & SysTick_CTRL_ENABLE_Msk)) {
+            systick.next_wrap = SIM_NEVER;
+        }
+        else if (!(was & SysTick_CTRL_ENABLE_Msk)) {
+            uint64_t counts = systick.val ? systick.val : (uint64_t)systick.load + 1U;
+            systick.next_wrap = now + counts * systick_scale();
+        }
+    }
+}
+
+static void systick_wrap(void) {
+
+    systick.ctrl |= SysTick_CTRL_COUNTFLAG_Msk;
+    if (systick.ctrl & SysTick_CTRL_TICKINT_Msk) {
+        nvic_pend(SysTick_IRQn);
+    }
+    systick.next_wrap += ((uint64_t)systick.load + 1U) * systick_scale();
+}
+
+// CYCCNT counts awake cycles only: the core clock is gated in WFI
+static uint32_t dwt_value(void) {
+
+    uint64_t awake = sim.cycles - sim_stats.sleep_cycles;
+
+    if ((dwt.demcr & CoreDebug_DEMCR_TRCENA_Msk) && (dwt.ctrl & DWT_CTRL_CYCCNTENA_Msk)) {
+        return dwt.count + (uint32_t)(awake - dwt.base);
+    }
+    return dwt.count;
+}
+
+static void dwt_writes(void) {
+
+    uint64_t awake = sim.cycles - sim_stats.sleep_cycles;
+
+    if (sim_dwt.CYCCNT != dwt.cyccnt) {
+        dwt.count = sim_dwt.CYCCNT;
+        dwt.base  = awake;
+    }
+    if (sim_dwt.CTRL != dwt.ctrl || sim_coredebug.DEMCR != dwt.demcr) {
+        dwt.count = dwt_value();
+        dwt.base  = awake;
+        dwt.ctrl  = sim_dwt.CTRL;
+        dwt.demcr = sim_coredebug.DEMCR;
+    }
+}
+
+// USART2 TX requests pace the channel: one byte per frame (start + 8 data + stop)
+static void dma7_writes(uint64_t now) {
+
+    DMA_Channel_TypeDef *ch = &sim_dma1_channel7;
+
+    if (ch->CCR != dma7.ccr) {
+        uint32_t set = ch->CCR & ~dma7.ccr;
+        dma7.ccr = ch->CCR;
+        if (set & DMA_CCR_EN) {
+            uint64_t byte = 10U * (uint64_t)(sim_usart2.BRR ? sim_usart2.BRR : 1U);
+            dma7.done = now + byte * (ch->CNDTR & 0xFFFFU);
+        }
+        if (!(dma7.ccr & DMA_CCR_EN)) {
+            dma7.done = SIM_NEVER;
+        }
+    }
+    if (sim_dma1.IFCR != 0) {
+        uint32_t clear = sim_dma1.IFCR;
+        if (clear & DMA_IFCR_CGIF7) {
+            clear |= DMA_ISR_GIF7 | DMA_ISR_TCIF7 | DMA_ISR_HTIF7 | DMA_ISR_TEIF7;
+        }
+        dma7.isr &= ~clear;
+        sim_dma1.IFCR = 0;
+    }
+    irq_line(&dma7.line, (dma7.isr & DMA_ISR_TCIF7) && (dma7.ccr & DMA_CCR_TCIE),
+             DMA1_Channel7_IRQn);
+}
+
+static void dma7_complete(void) {
+
+    sim_dma1_channel7.CNDTR = 0;
+    dma7.isr |= DMA_ISR_GIF7 | DMA_ISR_TCIF7;
+    dma7.done = SIM_NEVER;
+    irq_line(&dma7.line, (dma7.ccr & DMA_CCR_TCIE) != 0, DMA1_Channel7_IRQn);
+}
+
+// Guard (PROT_NONE) or open the host pages holding a damaged double word
+static void ecc_guard(int guard) {
+
+    for (uint32_t i = 0; i < ecc.count; i++) {
+        uintptr_t addr = ((uintptr_t)sim_flash_memory + ecc.offset[i]) & ~(ecc.page - 1U);
+        if (mprotect((void *)addr, ecc.page, guard ? PROT_NONE : PROT_READ | PROT_WRITE) != 0) {
+            perror("sim: mprotect");
+            abort();
+        }
+    }
+}
+
+// An access to a guarded page: ECCR and the NMI if it is a damaged double word, then
+// let the access run again on the open pages
+static void ecc_fault(int sig, siginfo_t *info, void *context) {
+
+    uintptr_t addr = (uintptr_t)info->si_addr;
+    uintptr_t base = (uintptr_t)sim_flash_memory;
+
+    (void)sig;
+    (void)context;
+    if (addr < base || addr >= base + SIM_FLASH_SIZE || ecc.count == 0) {
+        sigaction(SIGSEGV, &ecc.prev, NULL);    // not ours: fault again, as before
+        return;
+    }
+    ecc_guard(0);
+    ecc.open = 1;
+
+    uint32_t offset = (uint32_t)(addr - base) & ~7U;
+    for (uint32_t i = 0; i < ecc.count; i++) {
+        if (ecc.offset[i] == offset) {
+            flash.eccr = (flash.eccr & FLASH_ECCR_ECCIE) | FLASH_ECCR_ECCD |
+                         ((offset >= SIM_FLASH_SIZE / 2U) ? FLASH_ECCR_BK_ECC : 0U) |
+                         (offset % (SIM_FLASH_SIZE / 2U));
+            nvic_pend(NonMaskableInt_IRQn);
+        }
+    }
+}
+
+// Erase: the erased double words read back without error
+static void ecc_erase(uint32_t from, uint32_t size) {
+
+    uint32_t kept = 0;
+
+    for (uint32_t i = 0; i < ecc.count; i++) {
+        if (ecc.offset[i] < from || ecc.offset[i] >= from + size) {
+            ecc.offset[kept++] = ecc.offset[i];
+        }
+    }
+    ecc.count = kept;
+}
+
+// FLASH: KEYR unlock sequence, LOCK, page and bank erase (BSY for the erase time),
+// double ECC errors (ECCR, NMI). Programming is a plain store to sim_flash_memory, so it
+// is neither checked nor timed.
+static void flash_writes(uint64_t now) {
+
+    if (sim_flash.ECCR != flash.eccr) {         // ECCD, ECCC: write 1 to clear
+        uint32_t w = sim_flash.ECCR;
+        flash.eccr = (flash.eccr & ~(w & (FLASH_ECCR_ECCD | FLASH_ECCR_ECCC)) &
+                      ~FLASH_ECCR_ECCIE) | (w & FLASH_ECCR_ECCIE);
+    }
+    if (ecc.open) {
+        ecc_guard(1);
+        ecc.open = 0;
+    }
+
+    if (sim_flash.KEYR != flash.keyr) {
+        flash.keyr = sim_flash.KEYR;
+        if (flash.keyr == 0x45670123U) {
+            flash.key_stage = 1;
+        }
+        else {
+            if (flash.keyr == 0xCDEF89ABU && flash.key_stage) {
+                flash.cr    &= ~FLASH_CR_LOCK;
+                sim_flash.CR = flash.cr;
+            }
+            flash.key_stage = 0;
+        }
+    }
+    if (sim_flash.CR == flash.cr || (flash.cr & FLASH_CR_LOCK)) {
+        return;                                     // CR is read-only while locked
+    }
+
+    flash.cr = sim_flash.CR;
+    if (flash.cr & FLASH_CR_STRT) {
+        uint32_t bank = (flash.cr & FLASH_CR_BKER) ? 1U : 0U;
+        uint32_t page = (flash.cr & FLASH_CR_PNB) >> FLASH_CR_PNB_Pos;
+        ecc_guard(0);
+        if (flash.cr & FLASH_CR_PER) {
+            memset(&sim_flash_memory[(bank * 256U + page) * SIM_FLASH_PAGE_SIZE], 0xFF,
+                   SIM_FLASH_PAGE_SIZE);
+            ecc_erase((bank * 256U + page) * SIM_FLASH_PAGE_SIZE, SIM_FLASH_PAGE_SIZE);
+        }
+        if (flash.cr & FLASH_CR_MER1) {
+            memset(&sim_flash_memory[0], 0xFF, SIM_FLASH_SIZE / 2U);
+            ecc_erase(0, SIM_FLASH_SIZE / 2U);
+        }
+        if (flash.cr & FLASH_CR_MER2) {
+            memset(&sim_flash_memory[SIM_FLASH_SIZE / 2U], 0xFF, SIM_FLASH_SIZE / 2U);
+            ecc_erase(SIM_FLASH_SIZE / 2U, SIM_FLASH_SIZE / 2U);
+        }
+        ecc_guard(1);
+        flash.cr        &= ~FLASH_CR_STRT;
+        flash.busy_until = now + SIM_FLASH_ERASE_CYCLES;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  Event loop
+//-------------------------------------------------------------------------------------------
+static uint64_t sim_next_event(void) {
+
+    uint64_t t = SIM_NEVER;
+    uint64_t candidates[] = {
+        tim2.next_update, tim5.next_update, tim6.next_update, systick.next_wrap,
+        adc.cal_end, adc.ready_at, adc.conv_end, dma7.done,
+        pin_event_head < pin_event_count ? pin_events[pin_event_head].at : SIM_NEVER,
+    };
+
+    for (uint32_t i = 0; i < sizeof(candidates) / sizeof(candidates[0]); i++) {
+        if (candidates[i] < t) {
+            t = candidates[i];
+        }
+    }
+    return t;
+}
+
+// Run every peripheral event up to and including 'to', in time order
+static void sim_advance(uint64_t to) {
+
+    for (;;) {
+        uint64_t t = sim_next_event();
+        if (t > to) {
+            break;
+        }
+
+        if (tim5.next_update == t) timer_update(&tim5, t, 0);
+        if (tim6.next_update == t) timer_update(&tim6, t, 0);
+        if (tim2.next_update == t) timer_update(&tim2, t, 0);
+        if (systick.next_wrap == t) systick_wrap();
+        if (adc.cal_end == t) {
+            adc.cr     &= ~ADC_CR_ADCAL;
+            adc.cal_end = SIM_NEVER;
+        }
+        if (adc.ready_at == t) {
+            adc.isr     |= ADC_ISR_ADRDY;
+            adc.ready_at = SIM_NEVER;
+        }
+        if (adc.conv_end == t) adc_end(t);
+        if (dma7.done == t) dma7_complete();
+
+        while (pin_event_head < pin_event_count && pin_events[pin_event_head].at == t) {
+            const sim_pin_event_t *ev = &pin_events[pin_event_head++];
+            sim_gpio_t *g = &gpio[ev->port];
+            if (ev->level) {
+                g->ext_level |= 1UL << ev->pin;
+            }
+            else {
+                g->ext_level &= ~(1UL << ev->pin);
+            }
+            g->ext_driven |= 1UL << ev->pin;
+            gpio_refresh(g, ev->port, t);
+        }
+
+        irq_line(&adc.line, adc.isr & adc.ier & 0x7FFU, ADC1_2_IRQn);
+        exti_line_update();
+    }
+}
+
+static void sim_writes(uint64_t now) {
+
+    timer_writes(&tim2, now);
+    timer_writes(&tim5, now);
+    timer_writes(&tim6, now);
+    adc_writes(now);
+    for (uint32_t p = 0; p < SIM_PORT_COUNT; p++) {
+        if (gpio_writes(&gpio[p])) {
+            gpio_refresh(&gpio[p], p, now);
+        }
+    }
+    exti_writes();
+    systick_writes(now);
+    dwt_writes();
+    dma7_writes(now);
+    flash_writes(now);
+    irq_line(&adc.line, adc.isr & adc.ier & 0x7FFU, ADC1_2_IRQn);
+}
+
+static void sim_publish(uint64_t now) {
+
+    timer_publish(&tim2, now);
+    timer_publish(&tim5, now);
+    timer_publish(&tim6, now);
+
+    sim_adc1.CR  = adc.cr;
+    sim_adc1.ISR = adc.isr;
+    sim_adc1.DR  = adc.dr;
+
+    for (uint32_t p = 0; p < SIM_PORT_COUNT; p++) {
+        gpio[p].regs->ODR = gpio[p].odr;
+        gpio[p].regs->IDR = gpio[p].idr;
+    }
+    sim_exti.PR1 = exti.pr;
+
+    systick.val      = systick_value(now);
+    sim_systick.VAL  = systick.val;
+    sim_systick.CTRL = systick.ctrl;
+    sim_scb.ICSR     = nvic.pending[16 + SysTick_IRQn] ? SCB_ICSR_PENDSTSET_Msk : 0U;
+
+    dwt.cyccnt     = dwt_value();
+    sim_dwt.CYCCNT = dwt.cyccnt;
+
+    sim_dma1.ISR = dma7.isr;
+
+    sim_flash.CR = flash.cr;
+    sim_flash.SR = (now < flash.busy_until) ? FLASH_SR_BSY : 0U;   // no error flags
+    sim_flash.ECCR = flash.eccr;
+}
+
+// Bring the hardware up to sim.cycles and take the pending interrupts
+static void sim_sync(void) {
+
+    do {
+        sim_writes(sim.synced);
+        sim_advance(sim.cycles);
+        sim_publish(sim.cycles);
+        sim.synced = sim.cycles;
+
+        if (sim.cycles >= sim.stop_at) {
+            longjmp(sim.stop, 1);
+        }
+    } while (nvic_take());
+}
+
+//-------------------------------------------------------------------------------------------
+//  Reset state
+//-------------------------------------------------------------------------------------------
+static void sim_timer_reset(sim_timer_t *t, TIM_TypeDef *regs, IRQn_Type irq,
+                            uint32_t max, uint8_t extsel, uint8_t pwm) {
+
+    memset(t, 0, sizeof(*t));
+    t->regs        = regs;
+    t->irq         = irq;
+    t->max         = max;
+    t->extsel      = extsel;
+    t->pwm         = pwm;
+    t->arr         = max;
+    t->arr_act     = max;
+    t->next_update = SIM_NEVER;
+    regs->ARR      = max;
+}
+
+static void sim_reset(void) {
+
+    // 1. Register blocks
+    memset(&sim_rcc, 0, sizeof(sim_rcc));
+    memset(&sim_pwr, 0, sizeof(sim_pwr));
+    memset(&sim_flash, 0, sizeof(sim_flash));
+    memset(&sim_syscfg, 0, sizeof(sim_syscfg));
+    memset(&sim_exti, 0, sizeof(sim_exti));
+    memset(&sim_gpioa, 0, sizeof(sim_gpioa));
+    memset(&sim_gpioc, 0, sizeof(sim_gpioc));
+    memset(&sim_tim2, 0, sizeof(sim_tim2));
+    memset(&sim_tim5, 0, sizeof(sim_tim5));
+    memset(&sim_tim6, 0, sizeof(sim_tim6));
+    memset(&sim_adc1, 0, sizeof(sim_adc1));
+    memset(&sim_adc123_common, 0, sizeof(sim_adc123_common));
+    memset(&sim_usart2, 0, sizeof(sim_usart2));
+    memset(&sim_dma1, 0, sizeof(sim_dma1));
+    memset(&sim_dma1_channel7, 0, sizeof(sim_dma1_channel7));
+    memset(&sim_dma1_cselr, 0, sizeof(sim_dma1_cselr));
+    memset(&sim_scb, 0, sizeof(sim_scb));
+    memset(&sim_systick, 0, sizeof(sim_systick));
+    memset(&sim_dwt, 0, sizeof(sim_dwt));
+    memset(&sim_coredebug, 0, sizeof(sim_coredebug));
+    memset(&sim_mpu, 0, sizeof(sim_mpu));
+
+    sim_scb.CPUID      = 0x410FC241U;       // Cortex-M4 r0p1
+    sim_mpu.TYPE       = 8U << 8;           // 8 regions
+    sim_gpioa.MODER    = 0xABFFFFFFU;       // PA13/14/15 debug port, others analog
+    sim_gpioa.PUPDR    = 0x64000000U;
+    sim_gpioc.MODER    = 0xFFFFFFFFU;
+
+    // 2. Peripheral models (TIM2/TIM6 TRGO are ADC regular triggers EXT11 / EXT13)
+    sim_timer_reset(&tim2, &sim_tim2, TIM2_IRQn,     0xFFFFFFFFU, 11U, 1U);
+    sim_timer_reset(&tim5, &sim_tim5, TIM5_IRQn,     0xFFFFFFFFU, EXTSEL_NONE, 0U);
+    sim_timer_reset(&tim6, &sim_tim6, TIM6_DAC_IRQn, 0xFFFFU,     13U, 0U);
+
+    memset(&adc, 0, sizeof(adc));
+    adc.cr       = ADC_CR_DEEPPWD;
+    adc.cal_end  = SIM_NEVER;
+    adc.ready_at = SIM_NEVER;
+    adc.conv_end = SIM_NEVER;
+    sim_adc1.CR  = adc.cr;
+
+    memset(gpio, 0, sizeof(gpio));
+    gpio[SIM_PORT_A].regs      = &sim_gpioa;
+    gpio[SIM_PORT_A].exti_port = 0U;
+    gpio[SIM_PORT_C].regs      = &sim_gpioc;
+    gpio[SIM_PORT_C].exti_port = 2U;
+    for (uint32_t p = 0; p < SIM_PORT_COUNT; p++) {
+        gpio[p].idr   = gpio_levels(&gpio[p]);
+        gpio[p].moder = gpio[p].regs->MODER;
+        gpio[p].pupdr = gpio[p].regs->PUPDR;
+    }
+
+    memset(&exti, 0, sizeof(exti));
+    memset(&systick, 0, sizeof(systick));
+    systick.next_wrap = SIM_NEVER;
+    memset(&dwt, 0, sizeof(dwt));
+    memset(&dma7, 0, sizeof(dma7));
+    dma7.done = SIM_NEVER;
+
+    ecc_guard(0);
+    ecc.count = 0;
+    ecc.open  = 0;
+    if (!flash.blank) {
+        memset(sim_flash_memory, 0xFF, sizeof(sim_flash_memory));
+    }
+    memset(&flash, 0, sizeof(flash));
+    flash.blank    = 1;
+    flash.cr       = FLASH_CR_LOCK;
+    sim_flash.CR   = flash.cr;
+
+    // 3. NVIC: fixed priorities for NMI / HardFault, everything else 0 and disabled
+    memset(&nvic, 0, sizeof(nvic));
+    nvic.prio[16 + NonMaskableInt_IRQn] = -2;
+    nvic.prio[16 + HardFault_IRQn]      = -1;
+    for (uint32_t v = 0; v < 16U; v++) {
+        nvic.enabled[v] = 1;                // system exceptions cannot be disabled here
+    }
+
+    sim.cycles = 0;
+    sim.synced = 0;
+    memset(&sim_stats, 0, sizeof(sim_stats));
+}
+
+//-------------------------------------------------------------------------------------------
+//  Public interface
+//-------------------------------------------------------------------------------------------
+void *Sim_Access(volatile void *regs) {
+
+    sim.cycles += SIM_ACCESS_CYCLES;
+    sim_stats.accesses++;
+    sim_sync();
+    return (void *)regs;
+}
+
+int Sim_Run(uint64_t cycles) {
+
+    sim_reset();
+    sim.stop_at = cycles;
+
+    if (setjmp(sim.stop) != 0) {
+        return 0;
+    }
+    firmware_main();
+    return -1;
+}
+
+void Sim_Call(void (*fn)(void)) {
+
+    sim_reset();
+    sim.stop_at = SIM_NEVER;
+    fn();
+}
+
+uint64_t Sim_Cycles(void) {
+    return sim.cycles;
+}
+
+void Sim_SetAdcInput(sim_adc_input_t input) {
+    adc_input = input;
+}
+
+void Sim_OnPwmFrame(sim_pwm_hook_t hook) {
+    pwm_hook = hook;
+}
+
+void Sim_OnPin(sim_pin_hook_t hook) {
+    pin_hook = hook;
+}
+
+//-------------------------------------------------------------------------------------------
+//  Sim_SchedulePin
+//  Drive an input pin from outside at a given time (kept in time order; events at the
+//  same time keep the order they were scheduled in).
+//-------------------------------------------------------------------------------------------
+void Sim_SchedulePin(uint32_t port, uint32_t pin, uint32_t level, uint64_t at_cycles) {
+
+    if (port >= SIM_PORT_COUNT || pin > 15U || pin_event_count == SIM_PIN_EVENTS) {
+        fprintf(stderr, "sim: pin event dropped (port %u pin %u)\n", port, pin);
+        return;
+    }
+
+    uint32_t i = pin_event_count++;
+    while (i > pin_event_head && pin_events[i - 1U].at > at_cycles) {
+        pin_events[i] = pin_events[i - 1U];
+        i--;
+    }
+    pin_events[i] = (sim_pin_event_t){ at_cycles, (uint8_t)port, (uint8_t)pin, (uint8_t)(level != 0) };
+}
+
+//-------------------------------------------------------------------------------------------
+//  Sim_FlashEccError
+//-------------------------------------------------------------------------------------------
+void Sim_FlashEccError(uint32_t offset) {
+
+    offset &= ~7U;
+    if (offset >= SIM_FLASH_SIZE || ecc.count == SIM_FLASH_ECC_MAX) {
+        fprintf(stderr, "sim: ECC error at 0x%05x dropped\n", offset);
+        return;
+    }
+    if (ecc.page == 0U) {
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_sigaction = ecc_fault;
+        sa.sa_flags     = SA_SIGINFO | SA_NODEFER;
+        sigaction(SIGSEGV, &sa, &ecc.prev);
+        ecc.page = (uintptr_t)sysconf(_SC_PAGESIZE);
+        if (ecc.page > HOST_PAGE_MAX) {
+            fprintf(stderr, "sim: host page size %lu not supported\n", (unsigned long)ecc.page);
+            abort();
+        }
+    }
+    ecc_guard(0);
+    ecc.offset[ecc.count++] = offset;
+    ecc_guard(1);
+}
+
+//-------------------------------------------------------------------------------------------
+//  NVIC functions and core intrinsics (include/core_cm4.h)
+//-------------------------------------------------------------------------------------------
+void NVIC_SetPriorityGrouping(uint32_t PriorityGroup) {
+    (void)PriorityGroup;                    // 4 preemption bits, as set by Irq_Init()
+}
+
+void NVIC_EnableIRQ(IRQn_Type IRQn) {
+    nvic.enabled[IRQn + 16] = 1;
+    sim.cycles += SIM_INSTR_CYCLES;
+    sim_sync();
+}
+
+void NVIC_DisableIRQ(IRQn_Type IRQn) {
+    if (IRQn >= 0) {
+        nvic.enabled[IRQn + 16] = 0;
+    }
+    sim.cycles += SIM_INSTR_CYCLES;
+}
+
+void NVIC_SetPendingIRQ(IRQn_Type IRQn) {
+    nvic_pend(IRQn);
+    sim.cycles += SIM_INSTR_CYCLES;
+    sim_sync();
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn) {
+    if (nvic.pending[IRQn + 16]) {
+        nvic.pending[IRQn + 16] = 0;
+        nvic.pending_count--;
+    }
+    sim.cycles += SIM_INSTR_CYCLES;
+}
+
+uint32_t NVIC_GetPendingIRQ(IRQn_Type IRQn) {
+    return nvic.pending[IRQn + 16];
+}
+
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority) {
+    if (nvic.prio[IRQn + 16] >= 0) {
+        nvic.prio[IRQn + 16] = (int16_t)((priority << PRIO_SHIFT) & 0xFFU);
+    }
+}
+
+uint32_t NVIC_GetPriority(IRQn_Type IRQn) {
+    return nvic.prio[IRQn + 16] < 0 ? 0U : (uint32_t)nvic.prio[IRQn + 16] >> PRIO_SHIFT;
+}
+
+void __disable_irq(void) {
+    nvic.primask = 1;
+    sim.cycles += SIM_INSTR_CYCLES;
+}
+
+void __enable_irq(void) {
+    nvic.primask = 0;
+    sim.cycles += SIM_INSTR_CYCLES;
+    sim_sync();
+}
+
+uint32_t __get_PRIMASK(void) {
+    return nvic.primask;
+}
+
+void __set_PRIMASK(uint32_t priMask) {
+    nvic.primask = priMask & 1U;
+    sim.cycles += SIM_INSTR_CYCLES;
+    sim_sync();
+}
+
+uint32_t __get_BASEPRI(void) {
+    return nvic.basepri;
+}
+
+void __set_BASEPRI(uint32_t basePri) {
+    nvic.basepri = basePri & 0xFFU;
+    sim.cycles += SIM_INSTR_CYCLES;
+    sim_sync();
+}
+
+void __set_BASEPRI_MAX(uint32_t basePri) {
+    basePri &= 0xFFU;
+    if (basePri != 0U && (nvic.basepri == 0U || basePri < nvic.basepri)) {
+        nvic.basepri = basePri;
+    }
+    sim.cycles += SIM_INSTR_CYCLES;
+}
+
+uint32_t __get_MSP(void) {
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------
+//  __WFI
+//  Sleep until an interrupt that could preempt the current level is pending (PRIMASK
+//  does not prevent the wake-up, BASEPRI does). Time jumps from event to event.
+//  Stop 2 (SLEEPDEEP) is simulated as Sleep: the timers keep running.
+//-------------------------------------------------------------------------------------------
+void __WFI(void) {
+
+    sim.cycles += SIM_INSTR_CYCLES;
+    sim_stats.wfi++;
+    sim.woke = 0;
+    sim_sync();
+
+    while (!sim.woke && nvic_next() < 0) {
+        uint64_t next = sim_next_event();
+        if (next > sim.stop_at) {
+            next = sim.stop_at;
+        }
+        if (next > sim.cycles) {
+            sim_stats.sleep_cycles += next - sim.cycles;
+            sim.cycles = next;
+        }
+        sim_sync();
+    }
+}
+
+// The accesses before it are complete: their exceptions (flash ECC NMI) are taken
+void __DSB(void) {
+    sim.cycles += SIM_INSTR_CYCLES;
+    sim_sync();
+}
+
+void __ISB(void) {
+    sim.cycles += SIM_INSTR_CYCLES;
+}
+
+void __DMB(void) {
+    sim.cycles += SIM_INSTR_CYCLES;
+}
+
+void __NOP(void) {
+    sim.cycles += SIM_INSTR_CYCLES;
+}
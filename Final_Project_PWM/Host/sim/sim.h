@@ -0,0 +1,131 @@
+/*
+ * sim.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_SIM_H
+#define __STM32L476G_SIM_H
+
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+// Simulated STM32L476 for the host build.
+//
+// The firmware runs unchanged against plain register blocks (include/stm32l476xx.h,
+// include/core_cm4.h). Every peripheral access calls Sim_Access() first, which
+//   1. picks up what the firmware wrote since the previous access (compared with the
+//      values the simulator published),
+//   2. runs the peripherals up to the current simulated time, event by event,
+//   3. publishes the registers the hardware updates (TIMx->CNT, SysTick->VAL, ADC1->DR,
+//      DWT->CYCCNT, status flags ...),
+//   4. takes every pending, unmasked interrupt in NVIC priority order (nested).
+// Time only advances with register accesses, intrinsics, exception entry/exit and WFI;
+// WFI jumps straight to the next peripheral event, so an idle 20 ms frame costs a few
+// host microseconds.
+//
+// Modelled: TIM2/5/6 (count, prescaler, ARR/CCR1 preload, UG/URS, one-pulse, UIF,
+// TRGO on update), ADC1 (calibration, ADRDY, software and TRGO-triggered single
+// conversions with the SMPR/RES conversion time, EOC/EOS, DR), GPIOA/C (ODR, BSRR, BRR,
+// IDR from pull-ups or an external level), EXTI 0..15 (edges, IMR, PR, SWIER),
+// SysTick, DWT->CYCCNT (stopped in WFI), DMA1 channel 7 transfer-complete timing,
+// FLASH (unlock, lock, page and bank erase time, double ECC errors with ECCR and the NMI;
+// the memory is sim_flash_memory, blank at the first reset, programmed by plain stores),
+// NVIC priorities, PRIMASK and BASEPRI.
+// Everything else is plain memory.
+//
+// Known approximations, due to detecting writes by comparison:
+//   - Writing the value a register already holds is not seen. This matters for the
+//     write-1-to-clear flags: EXTI->PR1 lines are cleared when their handler returns.
+//   - Reads are not seen: ADC EOC/EOS are cleared when ADC1_2_IRQHandler returns (it
+//     reads DR) or when the next conversion starts.
+//   - Interrupts are pended on the rising edge of their request line, not re-pended
+//     if the line is still high when the handler returns.
+//   - A damaged flash double word (Sim_FlashEccError) raises its ECC error on the first
+//     access to its host page after a sync (register access, DSB ...); further accesses
+//     before the next sync are not seen.
+
+#define SIM_CLOCK_HZ            4000000U    // MSI 4 MHz: HCLK = PCLK1 = PCLK2
+#define SIM_ACCESS_CYCLES       2U          // one peripheral register access
+#define SIM_INSTR_CYCLES        1U          // one intrinsic (CPSID, MSR, DSB ...)
+#define SIM_EXC_ENTRY_CYCLES    12U         // exception entry (stacking + vector fetch)
+#define SIM_EXC_EXIT_CYCLES     10U         // exception return (unstacking)
+#define SIM_ADC_CAL_CYCLES      116U        // ADCAL duration in ADC clock cycles
+#define SIM_VDDA_MV             3300U       // ADC reference
+#define SIM_PIN_EVENTS          256U        // scheduled input changes
+#define SIM_FLASH_SIZE          (1024U * 1024U)
+#define SIM_FLASH_PAGE_SIZE     2048U
+#define SIM_FLASH_ECC_MAX       8U          // damaged double words
+
+#define SIM_US(us)              ((uint64_t)(us) * (SIM_CLOCK_HZ / 1000000U))
+#define SIM_MS(ms)              ((uint64_t)(ms) * (SIM_CLOCK_HZ / 1000U))
+
+#define SIM_FLASH_ERASE_CYCLES  SIM_US(22020)   // page erase, typical
+
+// GPIO ports with a register block in the simulator
+enum {
+    SIM_PORT_A,
+    SIM_PORT_C,
+    SIM_PORT_COUNT
+};
+
+// Analog input in millivolts for an ADC1 channel at a simulated time
+typedef uint32_t (*sim_adc_input_t)(uint32_t channel, uint64_t cycles);
+
+// One TIM2 frame, reported at its update event: CH1 is high for 'high' cycles out of
+// 'period' from 'start'. 'timebase' is TIM5->CNT at 'start', the clock of the firmware's
+// own timestamps (trace records, now_cycles()).
+typedef struct {
+    uint64_t start;
+    uint32_t timebase;
+    uint32_t high;
+    uint32_t period;
+} sim_frame_t;
+
+typedef void (*sim_pwm_hook_t)(const sim_frame_t *frame);
+
+// An output pin driven by ODR changed level
+typedef void (*sim_pin_hook_t)(uint32_t port, uint32_t pin, uint32_t level, uint64_t cycles);
+
+typedef struct {
+    uint64_t accesses;          // peripheral register accesses
+    uint64_t exceptions;        // handlers run (SysTick included)
+    uint64_t sleep_cycles;      // time spent in WFI
+    uint32_t adc_conversions;
+    uint32_t pwm_frames;
+    uint32_t wfi;
+} sim_stats_t;
+
+extern sim_stats_t sim_stats;
+
+// Entry point of the firmware: main() in Src/main.c, renamed by the host build.
+int firmware_main(void);
+
+// Modular function to run firmware_main() for 'cycles' of simulated time.
+// Returns 0 when the time is up, -1 if firmware_main() returned.
+// The firmware's static state is not reset: one run per process (fork for more).
+int Sim_Run(uint64_t cycles);
+
+// Modular function to call 'fn' on the simulated board from reset, with no time limit,
+// to drive firmware functions directly (e.g. bench_host.c) instead of firmware_main().
+void Sim_Call(void (*fn)(void));
+
+// Current simulated time in CPU cycles.
+uint64_t Sim_Cycles(void);
+
+// Inputs
+void Sim_SetAdcInput(sim_adc_input_t input);
+void Sim_SchedulePin(uint32_t port, uint32_t pin, uint32_t level, uint64_t at_cycles);
+
+// Modular function to damage the flash double word at 'offset' from FLASH_BASE, as a
+// program cut short by a reset can: reading it sets FLASH->ECCR ECCD (with its address)
+// and raises the NMI, and returns the stored words. Erasing its page repairs it.
+// Call from inside the run (Sim_Call), after the reset has blanked the memory.
+void Sim_FlashEccError(uint32_t offset);
+
+// Observers
+void Sim_OnPwmFrame(sim_pwm_hook_t hook);
+void Sim_OnPin(sim_pin_hook_t hook);
+
+#endif /* __STM32L476G_SIM_H */
@@ -0,0 +1,37 @@
+/*
+ * target_stubs.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ *
+ *  Target-only pieces the firmware links against, for the host build:
+ *    - g_pfnVectors comes from the startup file (VectorTable_RelocateToSRAM2 copies it)
+ *    - stack_monitor.c works on the linker-script stack bounds and the MPU; on the host
+ *      the firmware runs on the process stack, so there is nothing to paint or guard.
+ *      Fault_Stop() ends the process instead of holding the stop pulse.
+ */
+#include "mem_sections.h"
+#include "stack_monitor.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+const uint32_t g_pfnVectors[VECTOR_TABLE_ENTRIES] = {0};
+
+volatile stack_fault_t stack_fault = {0};
+
+void StackMonitor_Init(void) {
+}
+
+uint32_t StackMonitor_HighWater(void) {
+    return 0;
+}
+
+uint32_t StackMonitor_Size(void) {
+    return 0;
+}
+
+void Fault_Stop(void) {
+    fprintf(stderr, "firmware: Fault_Stop\n");
+    abort();
+}
@@ -0,0 +1,662 @@
+/*
+ * sim_scenarios.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ *
+ *  Randomized scenarios for the whole control loop: the unmodified firmware (Src/) on
+ *  the simulated STM32L476 (sim/), one forked process per scenario.
+ *
+ *  Each seed gives a 4..12 s run with
+ *    - a PC0 throttle made of 50..1500 ms segments (hold or linear ramp, 0..3.3 V)
+ *    - 0..4 PC13 presses held 30..1200 ms, each edge followed by 0..4 bounces (< 5 ms);
+ *      half of them within 200 us of a PWM frame edge
+ *  and every TIM2 frame is checked against the expected arming state:
+ *    - ARMED    : pulse = throttle sampled at the previous frame start (+/- 1 count)
+ *    - DISARMED, ARMING : stop pulse (1000 us), from the first frame after the press
+ *      (emergency stop) on
+ *  Frames within 20 us of a press, and the first two frames after arming (the new
+ *  throttle needs one frame to be sampled), are not checked. No task may overrun.
+ *
+ *  Per frame latency comes from the firmware's own trace (trace.h), with the same
+ *  definitions as latency.h: acquire, compute and total.
+ *
+ *  Usage: sim_scenarios [-n count] [-s first_seed] [-j jobs]
+ *         sim_scenarios -s seed --csv file     (one scenario, pulse train as CSV)
+ *         sim_scenarios -s seed --capture file (one scenario, its trace as a UART capture
+ *                                               for firmware_replay)
+ */
+#include "sim.h"
+#include "arming.h"
+#include "control.h"
+#include "scheduler.h"
+#include "trace.h"
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#define BUTTON_PIN          13U         // PC13, active low
+
+#define RUN_MS_MIN          4000U
+#define RUN_MS_MAX          12000U
+#define SEGMENT_MS_MIN      50U
+#define SEGMENT_MS_MAX      1500U
+#define PRESSES_MAX         4U
+#define HOLD_MS_MIN         30U
+#define HOLD_MS_MAX         1200U
+#define GAP_MS_MIN          50U         // released -> next press
+#define GAP_MS_MAX          2500U
+#define BOUNCES_MAX         4U
+#define BOUNCE_CYCLES       SIM_MS(5)
+#define FRAME_CYCLES        SIM_MS(20)
+#define EDGE_WINDOW         SIM_US(200)
+
+#define SEGMENTS_MAX        (RUN_MS_MAX / SEGMENT_MS_MIN + 1U)
+#define FRAMES_MAX          (RUN_MS_MAX / 20U + 8U)
+#define EVENTS_MAX          (2U * FRAMES_MAX + 64U)
+
+#define PRESS_SETTLE        SIM_US(20)  // press -> stop pulse written (EXTI entry + ISR)
+#define ARMED_SETTLE_MS     2U          // Arming_Task and timer wheel granularity
+#define TRACE_LAG           4U          // newest records may still be being written
+#define STOP_COUNTS         (CONTROL_PULSE_MIN_US / 20U)
+
+// Latency histograms: 2048 bins each
+enum {
+    LAT_ACQUIRE,
+    LAT_COMPUTE,
+    LAT_TOTAL,
+    LAT_COUNT
+};
+
+#define LAT_BINS            2048U
+
+static const char *const lat_names[LAT_COUNT] = { "acquire", "compute", "total" };
+static const uint32_t    lat_bin_us[LAT_COUNT] = { 1U, 1U, 20U };
+
+static const char *const state_names[ARMING_STATE_COUNT] = { "DISARMED", "ARMING", "ARMED" };
+
+typedef struct {
+    uint64_t start, len;
+    uint32_t from_mv, to_mv;
+} segment_t;
+
+typedef struct {
+    uint64_t at;
+    uint8_t  state;
+    uint8_t  press;             // 1 = button, 0 = boot or arming timeout
+} change_t;
+
+typedef struct {
+    uint64_t  run;
+    uint32_t  segment_count;
+    segment_t segments[SEGMENTS_MAX];
+    uint32_t  press_count;
+    uint64_t  press_at[PRESSES_MAX];
+    uint32_t  change_count;     // expected state changes (oracle)
+    change_t  changes[2U * PRESSES_MAX + 1U];
+} scenario_t;
+
+// What one scenario sends back to the parent
+typedef struct {
+    uint32_t seed;
+    uint32_t done;
+    uint64_t run;
+    uint32_t frames, checked, presses, failures, late;
+    uint32_t max_cycles[LAT_COUNT];
+    uint32_t hist[LAT_COUNT][LAT_BINS];
+    char     first_failure[160];
+} result_t;
+
+typedef struct {
+    uint32_t ts;
+    uint16_t id, arg;
+} event_t;
+
+static scenario_t scn;
+static sim_frame_t frames[FRAMES_MAX];
+static uint32_t    frame_count;
+static event_t     events[EVENTS_MAX];
+static uint32_t    event_count;
+static uint32_t    drained;
+static uint32_t    overruns;
+static uint32_t    trace_overrun;
+static FILE       *capture;
+
+//-------------------------------------------------------------------------------------------
+//  Scenario generation (xorshift64*, seeded through splitmix64)
+//-------------------------------------------------------------------------------------------
+static uint64_t rng;
+
+static uint64_t rng_next(void) {
+    rng ^= rng >> 12;
+    rng ^= rng << 25;
+    rng ^= rng >> 27;
+    return rng * 0x2545F4914F6CDD1DULL;
+}
+
+static uint32_t rng_range(uint32_t lo, uint32_t hi) {
+    return lo + (uint32_t)(rng_next() % (hi - lo + 1U));
+}
+
+static void rng_seed(uint32_t seed) {
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    rng = (z ^ (z >> 31)) | 1U;
+}
+
+static void expect(uint64_t at, uint8_t state, uint8_t press) {
+    scn.changes[scn.change_count++] = (change_t){ at, state, press };
+}
+
+// A press edge at 'at' to 'level', with contact bounce right after it
+static void schedule_edge(uint64_t at, uint32_t level) {
+
+    uint32_t bounces = 2U * rng_range(0, BOUNCES_MAX / 2U);
+    uint64_t t       = at;
+
+    Sim_SchedulePin(SIM_PORT_C, BUTTON_PIN, level, at);
+    for (uint32_t i = 0; i < bounces; i++) {
+        t += 1U + rng_next() % (BOUNCE_CYCLES / (bounces + 1U));
+        Sim_SchedulePin(SIM_PORT_C, BUTTON_PIN, (i & 1U) ? level : !level, t);
+    }
+}
+
+static void scenario_make(uint32_t seed) {
+
+    uint64_t t;
+    uint64_t armed_at = 0;
+    uint8_t  state    = ARMING_STATE_ARMED;     // Arming_Init(ARMING_STATE_ARMED)
+
+    memset(&scn, 0, sizeof(scn));
+    rng_seed(seed);
+    scn.run = SIM_MS(rng_range(RUN_MS_MIN, RUN_MS_MAX));
+
+    // 1. Throttle
+    uint32_t mv = rng_range(0, SIM_VDDA_MV);
+    for (t = 0; t < scn.run; ) {
+        segment_t *s = &scn.segments[scn.segment_count++];
+        s->start   = t;
+        s->len     = SIM_MS(rng_range(SEGMENT_MS_MIN, SEGMENT_MS_MAX));
+        s->from_mv = mv;
+        s->to_mv   = (rng_next() & 1U) ? mv : rng_range(0, SIM_VDDA_MV);
+        mv = s->to_mv;
+        t += s->len;
+    }
+
+    // 2. Button (released at reset) and the expected state changes
+    Sim_SchedulePin(SIM_PORT_C, BUTTON_PIN, 1, 0);
+    expect(0, ARMING_STATE_ARMED, 0);
+
+    uint32_t presses = rng_range(0, PRESSES_MAX);
+    t = 0;
+    for (uint32_t i = 0; i < presses; i++) {
+        uint64_t at   = t + SIM_MS(rng_range(GAP_MS_MIN, GAP_MS_MAX)) + rng_next() % SIM_MS(1);
+        uint64_t hold = SIM_MS(rng_range(HOLD_MS_MIN, HOLD_MS_MAX));
+
+        // Half of the presses within EDGE_WINDOW of a frame edge, where the stop pulse has
+        // the least time to make it (TIM2 starts shortly after reset, so its edges sit
+        // just past the 20 ms grid)
+        if (rng_next() & 1U) {
+            at = (at / FRAME_CYCLES + 1U) * FRAME_CYCLES - EDGE_WINDOW + rng_next() % (2U * EDGE_WINDOW);
+        }
+
+        // Keep clear of the arming timeout: a press right at it could go either way
+        if (state == ARMING_STATE_ARMING && at + SIM_MS(GAP_MS_MIN) > armed_at &&
+            at < armed_at + SIM_MS(GAP_MS_MIN)) {
+            at = armed_at + SIM_MS(GAP_MS_MIN);
+        }
+        if (at + hold + SIM_MS(GAP_MS_MIN) > scn.run) {
+            break;
+        }
+
+        if (state == ARMING_STATE_ARMING && at >= armed_at) {
+            expect(armed_at, ARMING_STATE_ARMED, 0);
+            state = ARMING_STATE_ARMED;
+        }
+        if (state == ARMING_STATE_ARMED) {
+            state = ARMING_STATE_DISARMED;
+            expect(at, state, 1);
+        }
+        else if (state == ARMING_STATE_DISARMED) {
+            state    = ARMING_STATE_ARMING;
+            armed_at = at + SIM_MS(ARMING_TIME_MS);
+            expect(at, state, 1);
+        }
+
+        schedule_edge(at, 0);
+        schedule_edge(at + hold, 1);
+        scn.press_at[scn.press_count++] = at;
+        t = at + hold;
+    }
+    if (state == ARMING_STATE_ARMING && armed_at < scn.run) {
+        expect(armed_at, ARMING_STATE_ARMED, 0);
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  Simulator hooks
+//-------------------------------------------------------------------------------------------
+static uint32_t throttle_mv(uint32_t channel, uint64_t cycles) {
+
+    static uint32_t i = 0;
+
+    (void)channel;
+    if (i >= scn.segment_count || cycles < scn.segments[i].start) {
+        i = 0;
+    }
+    while (i + 1U < scn.segment_count && cycles >= scn.segments[i + 1U].start) {
+        i++;
+    }
+
+    const segment_t *s = &scn.segments[i];
+    uint64_t dt = (cycles - s->start < s->len) ? cycles - s->start : s->len;
+
+    return (uint32_t)((int64_t)s->from_mv +
+                      ((int64_t)s->to_mv - (int64_t)s->from_mv) * (int64_t)dt / (int64_t)s->len);
+}
+
+// Copy the trace records of interest out of the firmware's circular buffer
+static void trace_drain(void) {
+
+    uint32_t head = trace_buffer.header.head;
+
+    if (head - drained > TRACE_RECORDS) {
+        trace_overrun = 1;
+        drained = head - TRACE_RECORDS;
+    }
+    static uint8_t header_written = 0;
+
+    if (capture && !header_written) {
+        fwrite(&trace_buffer.header, sizeof(trace_header_t), 1, capture);
+        header_written = 1;
+    }
+    while (head - drained > TRACE_LAG) {
+        const trace_record_t *r = &trace_buffer.records[drained++ & (TRACE_RECORDS - 1U)];
+
+        if (capture) {
+            fwrite(r, sizeof(*r), 1, capture);
+        }
+
+        if (r->id == TRACE_ID_TASK_OVERRUN) {
+            overruns++;
+        }
+        else if ((r->id == TRACE_ID_ADC_SAMPLE || r->id == TRACE_ID_PWM_COMMIT) &&
+                 event_count < EVENTS_MAX) {
+            // Keep them in time order: a record can be stamped after a later one when an
+            // interrupt lands between its slot reservation and its TIM5 read
+            uint32_t i = event_count++;
+            while (i > 0U && (int32_t)(events[i - 1U].ts - r->ts) > 0) {
+                events[i] = events[i - 1U];
+                i--;
+            }
+            events[i] = (event_t){ r->ts, r->id, r->arg };
+        }
+    }
+}
+
+static void pwm_frame(const sim_frame_t *frame) {
+
+    if (frame_count < FRAMES_MAX) {
+        frames[frame_count++] = *frame;
+    }
+    trace_drain();
+}
+
+//-------------------------------------------------------------------------------------------
+//  Checks
+//-------------------------------------------------------------------------------------------
+
+// Expected state at 'at'. Returns 0 if the frame is too close to a change to be checked.
+static int oracle(uint64_t at, uint64_t period, uint8_t *state) {
+
+    for (uint32_t i = 0; i < scn.change_count; i++) {
+        const change_t *c = &scn.changes[i];
+        uint64_t before = c->press ? 0 : SIM_MS(ARMED_SETTLE_MS);
+        uint64_t after  = c->press ? PRESS_SETTLE : 2U * period + SIM_MS(ARMED_SETTLE_MS);
+
+        if (at + before >= c->at && at < c->at + after) {
+            return 0;
+        }
+        if (c->at <= at) {
+            *state = c->state;
+        }
+    }
+    return 1;
+}
+
+static uint32_t expected_us(uint64_t sampled_at) {
+
+    uint32_t code = (uint32_t)(((uint64_t)throttle_mv(1, sampled_at) * 1023U + SIM_VDDA_MV / 2U) /
+                               SIM_VDDA_MV);
+
+    return CONTROL_PULSE_MIN_US + (code * 1000U) / 1023U;
+}
+
+static void fail(result_t *r, uint64_t at, const char *fmt, ...) {
+
+    if (r->failures++ == 0U) {
+        char    what[112];
+        va_list ap;
+
+        va_start(ap, fmt);
+        vsnprintf(what, sizeof(what), fmt, ap);
+        va_end(ap);
+        snprintf(r->first_failure, sizeof(r->first_failure), "%.3f ms: %s",
+                 (double)at * 1000.0 / SIM_CLOCK_HZ, what);
+    }
+}
+
+static void record_latency(result_t *r, uint32_t metric, uint32_t cycles) {
+
+    uint32_t bin = cycles / (SIM_CLOCK_HZ / 1000000U) / lat_bin_us[metric];
+
+    r->hist[metric][(bin < LAT_BINS) ? bin : LAT_BINS - 1U]++;
+    if (cycles > r->max_cycles[metric]) {
+        r->max_cycles[metric] = cycles;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  scenario_run
+//  Child process (or the only process with --csv): simulate one seed and check it.
+//-------------------------------------------------------------------------------------------
+static void scenario_run(uint32_t seed, result_t *r, FILE *csv) {
+
+    memset(r, 0, sizeof(*r));
+    r->seed = seed;
+
+    // 1. Scenario and simulation
+    scenario_make(seed);
+    Sim_SetAdcInput(throttle_mv);
+    Sim_OnPwmFrame(pwm_frame);
+
+    if (Sim_Run(scn.run) != 0) {
+        fail(r, Sim_Cycles(), "firmware_main returned");
+    }
+    trace_drain();
+
+    r->run     = scn.run;
+    r->frames  = frame_count;
+    r->presses = scn.press_count;
+
+    if (csv) {
+        fprintf(csv, "frame,start_us,pulse_us,state,expected_us,acquire_us,compute_us,total_us,check\n");
+    }
+
+    // 2. Pulse train against the oracle, latency from the trace
+    uint32_t e = 0;
+    for (uint32_t k = 0; k < frame_count; k++) {
+        const sim_frame_t *f = &frames[k];
+        uint32_t counts = f->high / (f->period / 1000U);
+        uint32_t want   = 0;
+        uint8_t  state  = ARMING_STATE_ARMED;
+        int      check  = (k >= 2U) && oracle(f->start, f->period, &state);
+        int      ok     = 1;
+
+        if (check) {
+            r->checked++;
+            if (state == ARMING_STATE_ARMED) {
+                want = expected_us(f->start - f->period) / 20U;
+                ok   = counts + 1U >= want && counts <= want + 1U;
+            }
+            else {
+                want = STOP_COUNTS;
+                ok   = counts == want;
+            }
+            if (!ok) {
+                fail(r, f->start, "pulse %u us, expected %u us (%s)", counts * 20U, want * 20U,
+                     state_names[state]);
+            }
+        }
+        else if (k >= 2U && (counts < STOP_COUNTS || counts > CONTROL_PULSE_MAX_US / 20U)) {
+            fail(r, f->start, "pulse %u us out of range", counts * 20U);
+        }
+
+        // Latency of the sample taken in the previous frame, applied at this one (once the
+        // trace has been read past this frame's start)
+        uint32_t lat[LAT_COUNT] = { 0 };
+        int      measured = 0;
+        int      traced   = event_count > 0U &&
+                            (int32_t)(events[event_count - 1U].ts - f->timebase) >= 0;
+
+        if (k >= 2U && traced) {
+            uint32_t frame = frames[k - 1U].timebase;
+            uint32_t apply = f->timebase;
+            uint32_t sample = 0, commit = 0;
+            int      have_sample = 0, have_commit = 0;
+
+            while (e < event_count && (int32_t)(events[e].ts - frame) < 0) {
+                e++;
+            }
+            for (uint32_t i = e; i < event_count && (int32_t)(events[i].ts - apply) < 0; i++) {
+                if (!have_sample && events[i].id == TRACE_ID_ADC_SAMPLE) {
+                    sample      = events[i].ts;
+                    have_sample = 1;
+                }
+                else if (have_sample && events[i].id == TRACE_ID_PWM_COMMIT) {
+                    commit      = events[i].ts;
+                    have_commit = 1;
+                    break;
+                }
+            }
+
+            if (have_commit) {
+                lat[LAT_ACQUIRE] = sample - frame;
+                lat[LAT_COMPUTE] = commit - sample;
+                lat[LAT_TOTAL]   = apply - frame;
+                for (uint32_t m = 0; m < LAT_COUNT; m++) {
+                    record_latency(r, m, lat[m]);
+                }
+                measured = 1;
+            }
+            else {
+                r->late++;
+            }
+        }
+
+        if (csv) {
+            fprintf(csv, "%u,%.1f,%u,%s,", k, (double)f->start * 1e6 / SIM_CLOCK_HZ, counts * 20U,
+                    check ? state_names[state] : "");
+            if (check) fprintf(csv, "%u", want * 20U);
+            if (measured) {
+                fprintf(csv, ",%.2f,%.2f,%.2f", lat[LAT_ACQUIRE] * 1e6 / SIM_CLOCK_HZ,
+                        lat[LAT_COMPUTE] * 1e6 / SIM_CLOCK_HZ, lat[LAT_TOTAL] * 1e6 / SIM_CLOCK_HZ);
+            }
+            else {
+                fprintf(csv, ",,,");
+            }
+            fprintf(csv, ",%s\n", !check ? "skip" : ok ? "ok" : "FAIL");
+        }
+    }
+
+    // 3. Scheduler and trace health
+    for (uint32_t i = 0; i < task_count; i++) {
+        overruns += task_stats[i].overruns + task_stats[i].skipped;
+    }
+    if (overruns) {
+        fail(r, scn.run, "%u task overruns", overruns);
+    }
+    if (trace_overrun) {
+        fail(r, scn.run, "trace records lost before the runner read them");
+    }
+    r->done = 1;
+}
+
+//-------------------------------------------------------------------------------------------
+//  Report
+//-------------------------------------------------------------------------------------------
+static uint32_t percentile_us(const uint32_t *hist, uint32_t bin_us, uint64_t total, double p) {
+
+    uint64_t want = (uint64_t)((double)total * p + 0.5);
+    uint64_t seen = 0;
+
+    for (uint32_t b = 0; b < LAT_BINS; b++) {
+        seen += hist[b];
+        if (seen >= want && seen > 0U) {
+            return b * bin_us;
+        }
+    }
+    return LAT_BINS * bin_us;
+}
+
+static double elapsed_s(const struct timespec *t0) {
+
+    struct timespec t1;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    return (double)(t1.tv_sec - t0->tv_sec) + (double)(t1.tv_nsec - t0->tv_nsec) * 1e-9;
+}
+
+static int usage(void) {
+    fprintf(stderr, "usage: sim_scenarios [-n count] [-s first_seed] [-j jobs]\n"
+                    "       sim_scenarios -s seed [--csv file] [--capture file]\n");
+    return 2;
+}
+
+int main(int argc, char **argv) {
+
+    uint32_t    count = 1000, first = 1, jobs = (uint32_t)sysconf(_SC_NPROCESSORS_ONLN);
+    const char *csv_path = NULL, *capture_path = NULL;
+    struct timespec t0;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            return usage();
+        }
+        if (!strcmp(argv[i], "-n"))          count    = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-s"))     first    = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-j"))     jobs     = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--csv"))  csv_path = argv[++i];
+        else if (!strcmp(argv[i], "--capture")) capture_path = argv[++i];
+        else return usage();
+    }
+
+    // 1. One scenario in this process: pulse train to a CSV file, trace to a capture file
+    if (csv_path || capture_path) {
+        static result_t r;
+        FILE *csv = csv_path ? fopen(csv_path, "w") : NULL;
+
+        capture = capture_path ? fopen(capture_path, "wb") : NULL;
+        if ((csv_path && !csv) || (capture_path && !capture)) {
+            perror(csv && capture_path ? capture_path : csv_path);
+            return 2;
+        }
+        scenario_run(first, &r, csv);
+        if (csv) fclose(csv);
+        if (capture) fclose(capture);
+        printf("seed %u: %.2f s, %u frames, %u presses, %u checked: %s%s\n", r.seed,
+               (double)r.run / SIM_CLOCK_HZ, r.frames, r.presses, r.checked,
+               r.failures ? "FAIL at " : "ok", r.first_failure);
+        return r.failures ? 1 : 0;
+    }
+
+    // 2. Fork one child per scenario, 'jobs' at a time; results come back in shared memory
+    if (jobs == 0U) {
+        jobs = 1;
+    }
+    result_t *slots = mmap(NULL, jobs * sizeof(result_t), PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    pid_t    *pids  = calloc(jobs, sizeof(pid_t));
+    static result_t total;
+    uint64_t  simulated = 0;
+    uint32_t  next = 0, running = 0, failed = 0;
+
+    if (slots == MAP_FAILED || !pids) {
+        perror("sim_scenarios");
+        return 2;
+    }
+
+    printf("sim_scenarios: %u scenarios (seeds %u..%u), %u jobs\n", count, first,
+           first + count - 1U, jobs);
+    fflush(stdout);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    while (next < count || running) {
+        for (uint32_t s = 0; s < jobs && next < count; s++) {
+            if (pids[s] != 0) {
+                continue;
+            }
+            memset(&slots[s], 0, sizeof(result_t));
+            slots[s].seed = first + next;
+            pids[s] = fork();
+            if (pids[s] == 0) {
+                scenario_run(first + next, &slots[s], NULL);
+                _exit(0);
+            }
+            if (pids[s] < 0) {
+                perror("fork");
+                return 2;
+            }
+            next++;
+            running++;
+        }
+
+        int   status;
+        pid_t pid = wait(&status);
+        for (uint32_t s = 0; s < jobs; s++) {
+            if (pids[s] != pid) {
+                continue;
+            }
+            result_t *r = &slots[s];
+
+            if (!r->done || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                r->failures++;
+                snprintf(r->first_failure, sizeof(r->first_failure), "child %s %d",
+                         WIFSIGNALED(status) ? "killed by signal" : "exited with",
+                         WIFSIGNALED(status) ? WTERMSIG(status) : WEXITSTATUS(status));
+            }
+
+            simulated     += r->run;
+            total.frames  += r->frames;
+            total.checked += r->checked;
+            total.presses += r->presses;
+            total.late    += r->late;
+            for (uint32_t m = 0; m < LAT_COUNT; m++) {
+                for (uint32_t b = 0; b < LAT_BINS; b++) {
+                    total.hist[m][b] += r->hist[m][b];
+                }
+                if (r->max_cycles[m] > total.max_cycles[m]) {
+                    total.max_cycles[m] = r->max_cycles[m];
+                }
+            }
+            if (r->failures && failed++ < 20U) {
+                printf("  FAIL seed %u at %s\n", r->seed, r->first_failure);
+                printf("       repro: sim_scenarios -s %u --csv seed%u.csv\n", r->seed, r->seed);
+            }
+
+            pids[s] = 0;
+            running--;
+        }
+    }
+
+    // 3. Summary
+    double host_s = elapsed_s(&t0);
+    uint64_t measured = 0;
+
+    for (uint32_t b = 0; b < LAT_BINS; b++) {
+        measured += total.hist[LAT_TOTAL][b];
+    }
+
+    printf("Simulated %.1f s in %.2f s host (%.0fx real time)\n", (double)simulated / SIM_CLOCK_HZ,
+           host_s, (double)simulated / SIM_CLOCK_HZ / host_s);
+    printf("Frames %u, checked %u, presses %u, late (no fresh commit) %u\n", total.frames,
+           total.checked, total.presses, total.late);
+    printf("\nLatency (us)     p50     p99      max    (%llu frames)\n", (unsigned long long)measured);
+    for (uint32_t m = 0; m < LAT_COUNT; m++) {
+        printf("  %-10s %7u %7u %8.2f\n", lat_names[m],
+               percentile_us(total.hist[m], lat_bin_us[m], measured, 0.50),
+               percentile_us(total.hist[m], lat_bin_us[m], measured, 0.99),
+               (double)total.max_cycles[m] * 1e6 / SIM_CLOCK_HZ);
+    }
+    printf("\n%u of %u scenarios failed\n", failed, count);
+
+    munmap(slots, jobs * sizeof(result_t));
+    free(pids);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,266 @@
+/*
+ * timer_wheel_check.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ *
+ *  Randomized check of the timing wheel (Src/timer_wheel.c) against a reference model: a
+ *  flat array of expiry ticks, scanned every tick. Between ticks, random timers are
+ *  started (one-shot or periodic, delays from 0 ms up to beyond the 262 s wheel range),
+ *  re-armed while active, or stopped; the wheel is advanced one tick at a time or by a
+ *  burst of ticks at once, as after a long callback. The timers come in three groups, so
+ *  every level gets to expire:
+ *    - hot  (first quarter) : touched a few times per tick
+ *    - warm (second quarter): touched about every 100 ms
+ *    - cold (the rest)      : only started when idle, never re-armed or stopped, so
+ *                             their long delays run to the end From inside their callbacks,
+ *  periodic timers stop themselves after a set number of shots and some one-shots
+ *  restart themselves.
+ *
+ *  Every tick the wheel must have run exactly the callbacks the model expects, at the
+ *  tick they were due. The tick counter starts below 2^32 so it wraps during the run.
+ *
+ *  Usage: timer_wheel_check [-t ticks] [-n timers] [-s seed]   (default 3000000, 200, 1)
+ *  Exit status 1 on the first mismatch.
+ */
+#include "timer_wheel.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TIMERS_MAX      1024U
+#define FIRES_MAX       (TIMERS_MAX * 64U)
+#define WHEEL_RANGE     (1UL << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))   // 262144 ticks
+#define BURST_MAX       50U         // ticks processed by one TimerWheel_Advance()
+
+// Reference model of one timer
+typedef struct {
+    uint8_t  active;
+    uint32_t expires;       // absolute tick
+    uint32_t period;        // 0 = one-shot
+    uint32_t shots;         // periodic: callbacks left before it stops itself
+    uint32_t restart;       // one-shot: delay it restarts itself with (0 = none)
+} model_t;
+
+typedef struct {
+    uint32_t id;
+    uint32_t tick;
+} fire_t;
+
+static soft_timer_t timers[TIMERS_MAX];
+static model_t      model[TIMERS_MAX];
+static model_t      own[TIMERS_MAX];    // the callbacks' copy of shots / restart
+static uint32_t     timer_count = 200;
+static uint32_t     rng_state;
+
+static fire_t   fired[FIRES_MAX];   // from the wheel's callbacks
+static uint32_t fired_count;
+static fire_t   due[FIRES_MAX];     // from the model
+static uint32_t due_count;
+
+static uint32_t rnd(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// Delay of a start: mostly short, as the firmware's, but every level and beyond
+static uint32_t random_delay(void) {
+    switch (rnd() % 8U) {
+    case 0:  return rnd() % 4U;                             // due at once
+    case 1:
+    case 2:  return rnd() % 64U;                            // level 0
+    case 3:
+    case 4:  return rnd() % 4096U;                          // level 1
+    case 5:  return rnd() % WHEEL_RANGE;                    // level 2
+    case 6:  return WHEEL_RANGE - 64U + rnd() % 128U;       // around the wheel range
+    default: return WHEEL_RANGE + rnd() % (4U * WHEEL_RANGE);   // parked
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  callback
+//  The tick it fired for is its expiry (before the periodic re-arm added the period).
+//  The self-stop and self-restart decisions use a copy of the model's settings, taken
+//  at the start, so both sides agree.
+//-------------------------------------------------------------------------------------------
+static void callback(soft_timer_t *timer) {
+
+    uint32_t id = (uint32_t)(timer - timers);
+    model_t *m  = &own[id];
+    uint32_t tick;
+
+    if (m->period != 0U) {
+        tick = timer->expires - m->period;
+        if (m->shots != 0U && --m->shots == 0U) {
+            TimerWheel_Stop(timer);
+        }
+    }
+    else {
+        tick = timer->expires;
+        if (m->restart != 0U) {
+            // wheel_tick is tick + 1 while the callbacks of 'tick' run
+            TimerWheel_Start(timer, m->restart, 0, callback);
+            m->restart = 0;
+        }
+    }
+    if (fired_count < FIRES_MAX) {
+        fired[fired_count++] = (fire_t){ id, tick };
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  model_tick
+//  What the wheel must do when it processes 'tick'.
+//-------------------------------------------------------------------------------------------
+static void model_tick(uint32_t tick) {
+
+    for (uint32_t id = 0; id < timer_count; id++) {
+        model_t *m = &model[id];
+        if (!m->active || m->expires != tick) {
+            continue;
+        }
+        if (due_count < FIRES_MAX) {
+            due[due_count++] = (fire_t){ id, tick };
+        }
+        if (m->period != 0U) {
+            m->expires += m->period;
+            if (m->shots != 0U && --m->shots == 0U) {
+                m->active = 0;              // the callback stops it
+            }
+        }
+        else if (m->restart != 0U) {
+            m->expires = tick + 1U + m->restart;
+            m->restart = 0;                 // restarts once
+        }
+        else {
+            m->active = 0;
+        }
+    }
+}
+
+static int fire_cmp(const void *a, const void *b) {
+    const fire_t *x = a, *y = b;
+    if (x->tick != y->tick) return (x->tick > y->tick) - (x->tick < y->tick);
+    return (x->id > y->id) - (x->id < y->id);
+}
+
+//-------------------------------------------------------------------------------------------
+//  random_op
+//  Start, re-arm or (when 'may_stop') stop timer 'id', on the wheel and in the model.
+//  'now' is the next tick the wheel will process.
+//-------------------------------------------------------------------------------------------
+static void random_op(uint32_t id, uint32_t now, uint8_t may_stop) {
+
+    model_t *m = &model[id];
+
+    if (may_stop && rnd() % 4U == 0U) {
+        TimerWheel_Stop(&timers[id]);
+        m->active = 0;
+        return;
+    }
+
+    uint32_t delay  = random_delay();
+    uint32_t period = (rnd() % 3U == 0U) ? 1U + rnd() % 5000U : 0U;
+
+    m->active  = 1;
+    m->expires = now + delay;
+    m->period  = period;
+    m->shots   = period ? rnd() % 20U : 0U;     // 0: runs until stopped from outside
+    m->restart = (!period && rnd() % 4U == 0U) ? 1U + rnd() % 200U : 0U;
+    own[id]    = *m;
+    TimerWheel_Start(&timers[id], delay, period, callback);
+}
+
+static int usage(void) {
+    fprintf(stderr, "usage: timer_wheel_check [-t ticks] [-n timers] [-s seed]\n");
+    return 2;
+}
+
+int main(int argc, char **argv) {
+
+    uint32_t ticks = 3000000U, seed = 1;
+    uint64_t total = 0;
+
+    for (int i = 1; i < argc; i++) {
+        char *end;
+        if (i + 1 >= argc) {
+            return usage();
+        }
+        if (!strcmp(argv[i], "-t"))      ticks       = (uint32_t)strtoul(argv[++i], &end, 0);
+        else if (!strcmp(argv[i], "-n")) timer_count = (uint32_t)strtoul(argv[++i], &end, 0);
+        else if (!strcmp(argv[i], "-s")) seed        = (uint32_t)strtoul(argv[++i], &end, 0);
+        else return usage();
+        if (*end != '\0' || end == argv[i]) {
+            return usage();
+        }
+    }
+    if (timer_count == 0U || timer_count > TIMERS_MAX) {
+        return usage();
+    }
+    rng_state = seed * 2654435761U | 1U;
+
+    // 1. Empty wheel, its tick counter 1.5 wheel ranges below the 32-bit wrap
+    uint32_t now = (uint32_t)(0U - WHEEL_RANGE - WHEEL_RANGE / 2U);
+    TimerWheel_Init(now);
+
+    // 2. Random operations, then one tick or a burst of them, checked against the model
+    for (uint32_t done = 0; done < ticks; ) {
+        uint32_t burst = (rnd() % 16U == 0U) ? 1U + rnd() % BURST_MAX : 1U;
+
+        uint32_t hot  = (timer_count + 3U) / 4U;
+        uint32_t warm = (timer_count + 1U) / 2U - hot;
+        uint32_t cold = timer_count - hot - warm;
+
+        for (uint32_t k = rnd() % 4U; k > 0U; k--) {
+            random_op(rnd() % hot, now, 1);
+        }
+        if (warm != 0U && rnd() % 100U < warm) {
+            random_op(hot + rnd() % warm, now, 1);
+        }
+        if (cold != 0U) {
+            uint32_t id = hot + warm + rnd() % cold;
+            if (!model[id].active) {
+                random_op(id, now, 0);
+            }
+        }
+
+        fired_count = 0;
+        due_count   = 0;
+        TimerWheel_Advance(now + burst - 1U);
+        for (uint32_t k = 0; k < burst; k++) {
+            model_tick(now + k);
+        }
+
+        qsort(fired, fired_count, sizeof(fire_t), fire_cmp);
+        qsort(due, due_count, sizeof(fire_t), fire_cmp);
+        if (fired_count != due_count || memcmp(fired, due, due_count * sizeof(fire_t)) != 0) {
+            printf("FAIL at tick %u (+%u): wheel ran %u callbacks, model expects %u\n", now,
+                   burst, fired_count, due_count);
+            for (uint32_t k = 0; k < fired_count || k < due_count; k++) {
+                printf("  wheel %4d @ %10d   model %4d @ %10d\n",
+                       k < fired_count ? (int)fired[k].id : -1,
+                       k < fired_count ? (int)fired[k].tick : -1,
+                       k < due_count ? (int)due[k].id : -1, k < due_count ? (int)due[k].tick : -1);
+            }
+            return 1;
+        }
+        for (uint32_t id = 0; id < timer_count; id++) {
+            if (TimerWheel_IsActive(&timers[id]) != model[id].active) {
+                printf("FAIL at tick %u: timer %u active %u, model %u\n", now, id,
+                       TimerWheel_IsActive(&timers[id]), model[id].active);
+                return 1;
+            }
+        }
+
+        total += fired_count;
+        now   += burst;
+        done  += burst;
+    }
+
+    printf("OK: %u ticks, %u timers, %llu callbacks, seed %u\n", ticks, timer_count,
+           (unsigned long long)total, seed);
+    return 0;
+}
@@ -9,17 +9,18 @@
 #define __STM32L476G_ADC_H
 
 #include "stm32l476xx.h"
+#include "ring_buffer.h"
 #include <stdint.h>
 
 extern volatile uint32_t adc_result; // Declaration of global variable to store sampled ADC data
 
+// Samples from ADC1_2_IRQHandler (producer) to Control_Task (consumer), one per PWM frame
+RING_BUFFER_DEFINE(adc_samples, uint16_t, 16)
+extern adc_samples_t adc_samples;
+
 // Modular function to wake up ADC1 from the deep-power-down mode
 void ADC1_Wakeup (void);
 
-// Modular function to initialize ADC external input channels
-// In this sample, PC0 (ADC123_IN1) is used
-void ADC_Pin_Init(void);
-
 // Modular function to configure ADC common registers
 void ADC_Common_Configuration(void);
 
@@ -30,6 +31,13 @@ void ADC_Init(void);
 // Returns: 0–1023 for 0–3.3 V input
 uint16_t ADC_Read10bit(void);
 
+// Modular function to start hardware-triggered conversions (TIM2_TRGO) with EOC interrupt.
+// Call after ADC_Init() and PWM_Init(); each PWM frame then produces one sample.
+void ADC_StartTriggered(void);
+
+// ADC1/ADC2 Interrupt Handler: stores each sample for Control_Task()
+void ADC1_2_IRQHandler(void);
+
 #endif /* __STM32L476G_ADC_H */
 
 
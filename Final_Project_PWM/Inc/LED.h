@@ -10,8 +10,7 @@
 #include "stm32l476xx.h"
 
 
-// Modular function to initialize PA5 as an output pin, interfacing with the LD2 LED.
-void configure_LED_pin();
+// LD2 on PA5 (PIN_LED), configured as an output by Board_Pins_Init().
 
 // Modular function to turn on the LD2 LED.
 void turn_on_LED();
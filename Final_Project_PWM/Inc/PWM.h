@@ -11,23 +11,19 @@
 #include "stm32l476xx.h"
 #include <stdint.h>
 
-// Global variable to store the most recent PWM duty value (0..1023).
+// Global variable to store the most recent TIM2 CCR1 value (50..100 counts of 20 us).
 // Useful for monitoring/debugging in the Expressions window.
 extern volatile uint16_t pwm_duty;
 
-// Modular function to initialize the PWM output pin.
-// In this sample, PA5 (TIM2_CH1) is used to drive the LD2 LED with PWM.
-void PWM_Pin_Init(void);
-
 // Modular function to configure the timer used for PWM generation.
-// In this sample, TIM2 Channel 1 is used.
+// TIM2 Channel 1 drives PA0 (PIN_PWM_OUT, AF1) to the ESC: 20 ms frames.
 void PWM_Timer_Init(void);
 
-// Modular function to initialize PWM: configure both pin and timer.
+// Modular function to initialize PWM (the pin is set up by Board_Pins_Init()).
 void PWM_Init(void);
 
-// Modular function to set PWM duty cycle.
-// Input 'duty' is a 10-bit value: 0 (0%) to 1023 (≈100%).
+// Modular function to set the pulse width of the next frame.
+// Input 'us' is the pulse in microseconds, clamped to 1000..2000 us.
 void PWM_SetPulse_us(uint16_t us);
 
 
@@ -0,0 +1,60 @@
+/*
+ * arming.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_ARMING_H
+#define __STM32L476G_ARMING_H
+
+#include "ring_buffer.h"
+#include <stdint.h>
+
+// States
+#define ARMING_STATE_DISARMED   0   // LED off, ESC held at the stop pulse
+#define ARMING_STATE_ARMING     1   // fast blink (100 ms) for 3 s
+#define ARMING_STATE_ARMED      2   // heartbeat (500 ms toggle), PWM follows throttle
+#define ARMING_STATE_COUNT      3
+
+// Events
+#define ARMING_EV_BUTTON        0   // user button press
+#define ARMING_EV_TIMEOUT       1   // arming delay elapsed
+#define ARMING_EV_STOP          2   // event queue overflowed: disarm from any state
+#define ARMING_EV_COUNT         3
+
+#define ARMING_TIME_MS          3000    // default of PARAM_ARMING_TIME_MS (param_store.h)
+#define ARMING_BLINK_MS         100
+
+// Packed state word: [31:8] transition count, [7:0] state.
+// Written only by Arming_Task() with a single 32-bit store, so any context can read a
+// consistent state (and detect a change through the count) with one load.
+extern volatile uint32_t arming_state_word;
+
+#define ARMING_WORD_STATE(w)    ((uint8_t)((w) & 0xFFU))
+#define ARMING_WORD_COUNT(w)    ((w) >> 8)
+
+// Events from the button ISR (single producer) to Arming_Task (single consumer)
+RING_BUFFER_DEFINE(arming_events, uint8_t, 8)
+extern arming_events_t arming_events;
+
+// Modular function to enter the initial state (runs its entry action).
+void Arming_Init(uint8_t initial_state);
+
+// Modular function to queue an event from interrupt context.
+// A button press while ARMED also forces the ESC stop pulse immediately, before the
+// transition is processed. If the queue is full the event is dropped and a stop is
+// latched instead: the throttle stays off and Arming_Task disarms.
+void Arming_Post(uint8_t event);
+
+// Modular function to process queued events (main loop, 1 kHz task).
+void Arming_Task(void);
+
+// Current state (ARMING_STATE_*)
+uint8_t Arming_GetState(void);
+
+// Returns 1 if the throttle may drive the ESC: ARMED, no event pending that could
+// disarm and no stop latched. Call with interrupts masked together with the CCR commit.
+uint8_t Arming_ThrottleEnabled(void);
+
+#endif /* __STM32L476G_ARMING_H */
@@ -0,0 +1,64 @@
+/*
+ * bench.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_BENCH_H
+#define __STM32L476G_BENCH_H
+
+#include "board_config.h"
+#include <stdint.h>
+
+// Set to 1 (e.g. -DBENCH_ENABLE=1) to benchmark the kernels below at boot, before the
+// PWM output and the scheduler start. The same table is timed on the host by Host/bench_host.c.
+#ifndef BENCH_ENABLE
+#define BENCH_ENABLE    0
+#endif
+
+#define BENCH_ITERATIONS    256U        // calls per timed batch
+#define BENCH_REPEAT        5U          // batches per kernel; the fastest one is kept
+#define BENCH_CLOCK_HZ      BOARD_SYSCLK_HZ     // DWT->CYCCNT rate
+#define BENCH_JSON_SIZE     1536U
+
+// Kernel IDs
+enum {
+    BENCH_THROTTLE_MAP,     // Control_ThrottleToPulse_us() over 0..1023
+    BENCH_PWM_SET,          // PWM_SetPulse_us() over 1000..2023 us
+    BENCH_CONTROL_STEP,     // Control_Step(): map + arming check + CCR1 commit
+    BENCH_SAMPLE_QUEUE,     // adc_samples push + pop (ISR -> Control_Task hand-off)
+    BENCH_ARMING_CYCLE,     // ARMED -> DISARMED -> ARMING -> ARMED through Arming_Task()
+    BENCH_COUNT
+};
+
+// One kernel: run() calls it 'iterations' times in a loop
+typedef struct {
+    const char *name;
+    void      (*run)(uint32_t iterations);
+} bench_t;
+
+extern const bench_t  bench_table[BENCH_COUNT];
+extern const uint32_t bench_count;
+
+// Target results in CPU cycles, loop overhead removed, readable in the Expressions window
+typedef struct {
+    uint32_t iterations;
+    uint32_t cycles;                // fastest batch
+    uint32_t cycles_per_op_x100;    // cycles / iterations, in hundredths
+} bench_result_t;
+
+extern bench_result_t bench_results[BENCH_COUNT];
+
+// The same results as Google Benchmark JSON (Tools/bench_report.py), e.g. from GDB:
+//   dump binary memory bench.json bench_json bench_json+bench_json_len
+extern char     bench_json[BENCH_JSON_SIZE];
+extern uint32_t bench_json_len;
+
+// Modular function to time every kernel with DWT->CYCCNT (interrupts masked) and fill
+// bench_results and bench_json. Call after Param_Init() and before the trace, timer
+// wheel, PWM and arming initialization (main() step 6): the PWM writes then drive no
+// output, and the later inits discard the trace records and arming state it leaves.
+void Bench_Run(void);
+
+#endif /* __STM32L476G_BENCH_H */
@@ -0,0 +1,88 @@
+/*
+ * board_config.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_BOARD_CONFIG_H
+#define __STM32L476G_BOARD_CONFIG_H
+
+#include <stdint.h>
+
+// Clock, PWM and ADC parameters of the board. Register values and scale factors are
+// derived here at compile time, and each one is range-checked with _Static_assert, so
+// changing a parameter either builds correct values or fails to compile.
+
+//-------------------------------------------------------------------------------------------
+//  Parameters
+//-------------------------------------------------------------------------------------------
+#define BOARD_SYSCLK_HZ         4000000U    // MSI 4 MHz: HCLK = PCLK1 = PCLK2
+#define BOARD_TICK_HZ           1000U       // SysTick, scheduler and timer wheel tick
+
+#define PWM_FRAME_US            20000U      // ESC frame (50 Hz)
+#define PWM_COUNT_US            20U         // TIM2 resolution: one count
+
+#define ADC_RESOLUTION_BITS     10U         // 6, 8, 10 or 12
+#define ADC_THROTTLE_CHANNEL    1U          // PC0 = ADC123_IN1
+
+//-------------------------------------------------------------------------------------------
+//  Division by a constant as multiply and shift
+//
+//    CONFIG_MUL_SHIFT(x, num, den, s) = (x * M) >> s,   M = ceil(num * 2^s / den)
+//
+//  equals floor(x * num / den) for every x with x * (M * den - num * 2^s) < 2^s.
+//  CONFIG_RECIP_EXACT(max, num, den, s) checks that bound for 0..max, and that
+//  max * M fits in 32 bits, so the run-time code is one MUL and one LSR.
+//-------------------------------------------------------------------------------------------
+#define CONFIG_RECIP_MUL(num, den, s) \
+    ((uint32_t)((((uint64_t)(num) << (s)) + (den) - 1U) / (den)))
+
+#define CONFIG_RECIP_EXACT(max, num, den, s)                                                \
+    ((uint64_t)(max) * ((uint64_t)CONFIG_RECIP_MUL(num, den, s) * (den) -                   \
+                        ((uint64_t)(num) << (s))) < (1ULL << (s)) &&                        \
+     (uint64_t)(max) * CONFIG_RECIP_MUL(num, den, s) <= UINT32_MAX)
+
+#define CONFIG_MUL_SHIFT(x, num, den, s) \
+    (((uint32_t)(x) * CONFIG_RECIP_MUL(num, den, s)) >> (s))
+
+//-------------------------------------------------------------------------------------------
+//  TIM2 (PWM)
+//-------------------------------------------------------------------------------------------
+#define PWM_TIMER_HZ            (1000000U / PWM_COUNT_US)               // 50 kHz
+#define PWM_PSC                 (BOARD_SYSCLK_HZ / PWM_TIMER_HZ - 1U)   // 79
+#define PWM_ARR                 (PWM_FRAME_US / PWM_COUNT_US - 1U)      // 999
+
+// Pulse width in us -> CCR1 counts, exact up to one frame
+#define PWM_US_SHIFT            20U
+#define PWM_US_TO_COUNTS(us)    CONFIG_MUL_SHIFT((us), 1U, PWM_COUNT_US, PWM_US_SHIFT)
+
+_Static_assert(1000000U % PWM_COUNT_US == 0U, "PWM_COUNT_US must divide 1 s");
+_Static_assert(BOARD_SYSCLK_HZ % PWM_TIMER_HZ == 0U, "TIM2 clock must divide SYSCLK");
+_Static_assert(PWM_PSC <= 0xFFFFU, "TIM2 prescaler out of range");
+_Static_assert(PWM_FRAME_US % PWM_COUNT_US == 0U, "PWM frame must be whole counts");
+_Static_assert(PWM_ARR >= 99U && PWM_ARR <= 0xFFFFU, "PWM frame: 100..65536 counts");
+_Static_assert(CONFIG_RECIP_EXACT(PWM_FRAME_US, 1U, PWM_COUNT_US, PWM_US_SHIFT),
+               "PWM_US_TO_COUNTS is not exact over a frame");
+
+//-------------------------------------------------------------------------------------------
+//  SysTick, debounce timer, ADC
+//-------------------------------------------------------------------------------------------
+#define BOARD_TICK_RELOAD       (BOARD_SYSCLK_HZ / BOARD_TICK_HZ)       // 4000
+#define BOARD_CYCLES_PER_US     (BOARD_SYSCLK_HZ / 1000000U)
+#define BOARD_MS_TIMER_PSC      (BOARD_SYSCLK_HZ / 1000U - 1U)          // 1 kHz count (TIM6)
+
+#define ADC_FULL_SCALE          ((1U << ADC_RESOLUTION_BITS) - 1U)      // 1023
+#define ADC_CFGR_RES_VALUE      ((12U - ADC_RESOLUTION_BITS) / 2U)      // RES[1:0]
+
+_Static_assert(BOARD_SYSCLK_HZ % BOARD_TICK_HZ == 0U, "tick must divide SYSCLK");
+_Static_assert(BOARD_TICK_RELOAD >= 1U && BOARD_TICK_RELOAD <= 0x1000000U,
+               "SysTick reload is 24 bits");
+_Static_assert(BOARD_SYSCLK_HZ % 1000000U == 0U, "SYSCLK must be whole MHz");
+_Static_assert(BOARD_MS_TIMER_PSC <= 0xFFFFU, "1 kHz timer prescaler out of range");
+_Static_assert(ADC_RESOLUTION_BITS >= 6U && ADC_RESOLUTION_BITS <= 12U &&
+               ADC_RESOLUTION_BITS % 2U == 0U, "ADC resolution: 6, 8, 10 or 12 bits");
+_Static_assert(ADC_THROTTLE_CHANNEL >= 1U && ADC_THROTTLE_CHANNEL <= 18U,
+               "ADC1 regular channel out of range");
+
+#endif /* __STM32L476G_BOARD_CONFIG_H */
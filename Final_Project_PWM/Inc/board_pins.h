@@ -0,0 +1,149 @@
+/*
+ * board_pins.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_BOARD_PINS_H
+#define __STM32L476G_BOARD_PINS_H
+
+#include "gpio.h"
+#include "trace.h"
+#include <stdint.h>
+
+// Resource registry of the board: every GPIO pin, DMA channel and timer channel the
+// firmware uses is listed once here, and nowhere else.
+//
+//   - Allocating a pin, a DMA channel or a timer channel twice fails to compile.
+//   - PIN_<name> is the gpio_pin_t of each pin (Gpio_Set(PIN_LED) ...).
+//   - Board_Pins_Init() configures all pins at once: the register values of each port
+//     are folded at compile time, so every GPIO register is written once.
+//
+// To add a resource, add a line to the table; the checks and the init follow.
+
+//-------------------------------------------------------------------------------------------
+//  GPIO pins
+//  X(arg, name, port, pin, mode, output type, pull, alternate function)
+//  Analog pins also get their analog switch closed (GPIOx_ASCR, ADC inputs).
+//-------------------------------------------------------------------------------------------
+#define BOARD_PINS(X, arg)                                                                      \
+    X(arg, PWM_OUT,  GPIO_PORT_A,  0, GPIO_MODE_AF,     GPIO_PUSH_PULL, GPIO_NO_PULL, 1)  /* TIM2_CH1 -> ESC  */ \
+    X(arg, TRACE_TX, GPIO_PORT_A,  2, TRACE_UART ? GPIO_MODE_AF : GPIO_MODE_ANALOG,                              \
+                                                        GPIO_PUSH_PULL, GPIO_NO_PULL, 7)  /* USART2_TX        */ \
+    X(arg, LED,      GPIO_PORT_A,  5, GPIO_MODE_OUTPUT, GPIO_PUSH_PULL, GPIO_NO_PULL, 0)  /* LD2              */ \
+    X(arg, THROTTLE, GPIO_PORT_C,  0, GPIO_MODE_ANALOG, GPIO_PUSH_PULL, GPIO_NO_PULL, 0)  /* ADC123_IN1       */ \
+    X(arg, BUTTON,   GPIO_PORT_C, 13, GPIO_MODE_INPUT,  GPIO_PUSH_PULL, GPIO_PULL_UP, 0)  /* B1, active low   */
+
+//-------------------------------------------------------------------------------------------
+//  DMA channels
+//  X(arg, name, controller 1..2, channel 1..7, request CxS 0..7)
+//-------------------------------------------------------------------------------------------
+#define BOARD_DMA_CHANNELS(X, arg)                                                              \
+    X(arg, TRACE_TX_DMA, 1, 7, 2)       /* USART2_TX */
+
+//-------------------------------------------------------------------------------------------
+//  Timer channels
+//  X(arg, name, timer, channel)
+//  Channel 0 is the time base (PSC, ARR, update event); its TRGO may be used by others
+//  (TIM2 TRGO starts the ADC conversions). Channels 1..4 are capture/compare.
+//-------------------------------------------------------------------------------------------
+#define BOARD_TIMER_CHANNELS(X, arg)                                                            \
+    X(arg, PWM_FRAME,   2, 0)           /* 20 ms frame, ADC trigger        */                 \
+    X(arg, PWM_PULSE,   2, 1)           /* CCR1 -> PWM_OUT                 */                 \
+    X(arg, TIMEBASE,    5, 0)           /* 32-bit free-running clock       */                 \
+    X(arg, DEBOUNCE,    6, 0)           /* one-pulse button debounce       */
+
+//-------------------------------------------------------------------------------------------
+//  Pin descriptors: PIN_<name>
+//-------------------------------------------------------------------------------------------
+#define BOARD_PIN_DEFINE_(arg, name, port, pin, mode, otype, pull, af) \
+    static const gpio_pin_t PIN_##name = { (port), (pin), (mode), (otype), (pull), (af) };
+BOARD_PINS(BOARD_PIN_DEFINE_, 0)
+
+//-------------------------------------------------------------------------------------------
+//  Register values per port, as constant expressions
+//  Each X(P, ...) contributes its field when the pin is on port P.
+//-------------------------------------------------------------------------------------------
+#define BOARD_ON_(P, port, value)   ((port) == (P) ? (uint32_t)(value) : 0UL)
+
+#define BOARD_PIN_BIT_(P, name, port, pin, mode, otype, pull, af)     | BOARD_ON_(P, port, 1UL << (pin))
+#define BOARD_PIN_SUM_(P, name, port, pin, mode, otype, pull, af)     + BOARD_ON_(P, port, 1UL << (pin))
+#define BOARD_PIN_MODER_(P, name, port, pin, mode, otype, pull, af)   | BOARD_ON_(P, port, (uint32_t)(mode) << (2U * (pin)))
+#define BOARD_PIN_OTYPER_(P, name, port, pin, mode, otype, pull, af)  | BOARD_ON_(P, port, (uint32_t)(otype) << (pin))
+#define BOARD_PIN_PUPDR_(P, name, port, pin, mode, otype, pull, af)   | BOARD_ON_(P, port, (uint32_t)(pull) << (2U * (pin)))
+#define BOARD_PIN_AFRL_(P, name, port, pin, mode, otype, pull, af) \
+    | BOARD_ON_(P, port, (pin) < 8U ? (uint32_t)(af) << (4U * ((pin) & 7U)) : 0UL)
+#define BOARD_PIN_AFRH_(P, name, port, pin, mode, otype, pull, af) \
+    | BOARD_ON_(P, port, (pin) >= 8U ? (uint32_t)(af) << (4U * ((pin) & 7U)) : 0UL)
+#define BOARD_PIN_ASCR_(P, name, port, pin, mode, otype, pull, af) \
+    | BOARD_ON_(P, port, (mode) == GPIO_MODE_ANALOG ? 1UL << (pin) : 0UL)
+
+#define BOARD_PORT_PINS(P)      (0UL BOARD_PINS(BOARD_PIN_BIT_, P))
+#define BOARD_PORT_MODER(P)     (0UL BOARD_PINS(BOARD_PIN_MODER_, P))
+#define BOARD_PORT_OTYPER(P)    (0UL BOARD_PINS(BOARD_PIN_OTYPER_, P))
+#define BOARD_PORT_PUPDR(P)     (0UL BOARD_PINS(BOARD_PIN_PUPDR_, P))
+#define BOARD_PORT_AFRL(P)      (0UL BOARD_PINS(BOARD_PIN_AFRL_, P))
+#define BOARD_PORT_AFRH(P)      (0UL BOARD_PINS(BOARD_PIN_AFRH_, P))
+#define BOARD_PORT_ASCR(P)      (0UL BOARD_PINS(BOARD_PIN_ASCR_, P))
+
+// Field masks: the bits of the pins on port P
+#define BOARD_PIN_MASK2_(P, name, port, pin, mode, otype, pull, af)   | BOARD_ON_(P, port, 3UL << (2U * (pin)))
+#define BOARD_PIN_MASKL_(P, name, port, pin, mode, otype, pull, af) \
+    | BOARD_ON_(P, port, (pin) < 8U ? 0xFUL << (4U * ((pin) & 7U)) : 0UL)
+#define BOARD_PIN_MASKH_(P, name, port, pin, mode, otype, pull, af) \
+    | BOARD_ON_(P, port, (pin) >= 8U ? 0xFUL << (4U * ((pin) & 7U)) : 0UL)
+
+#define BOARD_PORT_MASK2(P)     (0UL BOARD_PINS(BOARD_PIN_MASK2_, P))
+#define BOARD_PORT_MASK_AFRL(P) (0UL BOARD_PINS(BOARD_PIN_MASKL_, P))
+#define BOARD_PORT_MASK_AFRH(P) (0UL BOARD_PINS(BOARD_PIN_MASKH_, P))
+
+//-------------------------------------------------------------------------------------------
+//  Allocation checks
+//  A set of distinct bits sums to its OR; a bit allocated twice carries into the next.
+//-------------------------------------------------------------------------------------------
+#define BOARD_PIN_CHECK_(arg, name, port, pin, mode, otype, pull, af)                       \
+    _Static_assert((port) == GPIO_PORT_A || (port) == GPIO_PORT_B || (port) == GPIO_PORT_C || \
+                   (port) == GPIO_PORT_D || (port) == GPIO_PORT_H, #name ": no such port");  \
+    _Static_assert((pin) < 16U && (mode) <= 3U && (otype) <= 1U && (pull) <= 2U &&            \
+                   (af) < 16U, #name ": pin field out of range");
+BOARD_PINS(BOARD_PIN_CHECK_, 0)
+
+#define BOARD_PORT_UNIQUE(P)    ((0UL BOARD_PINS(BOARD_PIN_SUM_, P)) == BOARD_PORT_PINS(P))
+_Static_assert(BOARD_PORT_UNIQUE(GPIO_PORT_A), "a GPIOA pin is allocated twice");
+_Static_assert(BOARD_PORT_UNIQUE(GPIO_PORT_B), "a GPIOB pin is allocated twice");
+_Static_assert(BOARD_PORT_UNIQUE(GPIO_PORT_C), "a GPIOC pin is allocated twice");
+_Static_assert(BOARD_PORT_UNIQUE(GPIO_PORT_D), "a GPIOD pin is allocated twice");
+_Static_assert(BOARD_PORT_UNIQUE(GPIO_PORT_H), "a GPIOH pin is allocated twice");
+
+#define BOARD_DMA_BIT_(arg, name, dma, ch, req)     | (1UL << (((dma) - 1U) * 7U + (ch) - 1U))
+#define BOARD_DMA_SUM_(arg, name, dma, ch, req)     + (1UL << (((dma) - 1U) * 7U + (ch) - 1U))
+#define BOARD_DMA_CHECK_(arg, name, dma, ch, req)                                           \
+    _Static_assert((dma) >= 1U && (dma) <= 2U && (ch) >= 1U && (ch) <= 7U && (req) <= 7U,    \
+                   #name ": DMA channel out of range");
+BOARD_DMA_CHANNELS(BOARD_DMA_CHECK_, 0)
+_Static_assert((0UL BOARD_DMA_CHANNELS(BOARD_DMA_SUM_, 0)) ==
+               (0UL BOARD_DMA_CHANNELS(BOARD_DMA_BIT_, 0)), "a DMA channel is allocated twice");
+
+// Per timer T: channel bits, with the time base (channel 0) as bit 0
+#define BOARD_TIM_BIT_(T, name, tim, ch)            | ((tim) == (T) ? 1UL << (ch) : 0UL)
+#define BOARD_TIM_SUM_(T, name, tim, ch)            + ((tim) == (T) ? 1UL << (ch) : 0UL)
+#define BOARD_TIM_CHECK_(arg, name, tim, ch)                                                \
+    _Static_assert(((tim) >= 1U && (tim) <= 8U) || ((tim) >= 15U && (tim) <= 17U),           \
+                   #name ": no such timer");                                                 \
+    _Static_assert((ch) <= 4U, #name ": timer channel out of range");
+BOARD_TIMER_CHANNELS(BOARD_TIM_CHECK_, 0)
+
+#define BOARD_TIM_UNIQUE(T)                                                                 \
+    ((0UL BOARD_TIMER_CHANNELS(BOARD_TIM_SUM_, T)) == (0UL BOARD_TIMER_CHANNELS(BOARD_TIM_BIT_, T)))
+_Static_assert(BOARD_TIM_UNIQUE(1U) && BOARD_TIM_UNIQUE(2U) && BOARD_TIM_UNIQUE(3U) &&
+               BOARD_TIM_UNIQUE(4U) && BOARD_TIM_UNIQUE(5U) && BOARD_TIM_UNIQUE(6U) &&
+               BOARD_TIM_UNIQUE(7U) && BOARD_TIM_UNIQUE(8U) && BOARD_TIM_UNIQUE(15U) &&
+               BOARD_TIM_UNIQUE(16U) && BOARD_TIM_UNIQUE(17U),
+               "a timer channel is allocated twice");
+
+// Modular function to configure every pin of BOARD_PINS, one write per GPIO register.
+// Call once at start-up, before the drivers that use the pins.
+void Board_Pins_Init(void);
+
+#endif /* __STM32L476G_BOARD_PINS_H */
@@ -9,8 +9,41 @@
 #define __STM32L476G_BUTTON_H
 
 #include "stm32l476xx.h"
+#include "ring_buffer.h"
+#include <stdint.h>
 
-// Modular function to initialize PC13 as an input pin with EXTI interrupt.
+// Debounce and gesture timing
+#define BUTTON_DEBOUNCE_MS   20     // contact ignored this long after each edge
+#define BUTTON_LONG_MS       1000   // held at least this long -> LONG
+#define BUTTON_DOUBLE_MS     400    // second press within this gap after a SHORT -> DOUBLE
+
+// Button event types
+#define BUTTON_EVENT_PRESS   1      // press edge (drives arm/disarm)
+#define BUTTON_EVENT_SHORT   2      // released before BUTTON_LONG_MS
+#define BUTTON_EVENT_LONG    3      // released after BUTTON_LONG_MS
+#define BUTTON_EVENT_DOUBLE  4      // second SHORT press within BUTTON_DOUBLE_MS
+
+typedef struct {
+    uint32_t time_us;   // low 32 bits of now_us() at the edge
+    uint8_t  type;      // BUTTON_EVENT_*
+} button_event_t;
+
+// Events from EXTI15_10_IRQHandler (producer) to the main loop (consumer)
+RING_BUFFER_DEFINE(button_events, button_event_t, 16)
+extern button_events_t button_events;
+
+// Modular function to initialize the EXTI interrupt of PC13 (an input from
+// Board_Pins_Init) and the TIM6 debounce timer.
 void button_Init(void);
 
+// Returns 1 while the debounce timer runs (EXTI13 masked). TIM6 halts in Stop 2,
+// so the core must not enter Stop 2 in that window or the button stays masked.
+uint8_t button_Busy(void);
+
+// EXTI Line[15:10] Interrupt Handler: first edge of a press/release
+void EXTI15_10_IRQHandler(void);
+
+// TIM6 Interrupt Handler: end of the debounce period
+void TIM6_DACUNDER_IRQHandler(void);
+
 #endif /* __STM32L476G_BUTTON_H */
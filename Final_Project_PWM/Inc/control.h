@@ -0,0 +1,26 @@
+/*
+ * control.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_CONTROL_H
+#define __STM32L476G_CONTROL_H
+
+#include <stdint.h>
+
+// ESC pulse endpoints in microseconds: defaults of PARAM_PULSE_MIN_US / PARAM_PULSE_MAX_US
+#define CONTROL_PULSE_MIN_US   1000
+#define CONTROL_PULSE_MAX_US   2000
+#define CONTROL_PULSE_SPAN_US  (CONTROL_PULSE_MAX_US - CONTROL_PULSE_MIN_US)
+
+// Modular function to map a 10-bit throttle sample (0..1023) to an ESC pulse width.
+// Returns: PARAM_PULSE_MIN_US..PARAM_PULSE_MAX_US (1000..2000 us)
+uint16_t Control_ThrottleToPulse_us(uint16_t value);
+
+// Modular function to run one control step with a new throttle sample.
+// Called by Control_Task() once per PWM frame, when a new ADC sample is available.
+void Control_Step(uint16_t value);
+
+#endif /* __STM32L476G_CONTROL_H */
@@ -0,0 +1,97 @@
+/*
+ * gpio.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_GPIO_H
+#define __STM32L476G_GPIO_H
+
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+// GPIO pins described by constant tables.
+//
+//   Gpio_Set(PIN_LED);    // one store to BSRR
+//
+// The descriptors (PIN_<name>) and the pin configuration live in board_pins.h.
+//
+// Gpio_Set() and Gpio_Clear() are a single write to BSRR: no read-modify-write of ODR,
+// so an interrupt that drives another pin of the same port in between cannot be undone.
+// Gpio_Toggle() reads ODR but still writes only its own pin through BSRR. With a const
+// descriptor the port, mask and branch fold to constants: one STR to the port.
+
+// Ports, in RCC_AHB2ENR GPIOxEN bit order
+enum {
+    GPIO_PORT_A = 0,
+    GPIO_PORT_B = 1,
+    GPIO_PORT_C = 2,
+    GPIO_PORT_D = 3,
+    GPIO_PORT_H = 7
+};
+
+// MODER
+#define GPIO_MODE_INPUT         0U
+#define GPIO_MODE_OUTPUT        1U
+#define GPIO_MODE_AF            2U
+#define GPIO_MODE_ANALOG        3U
+
+// OTYPER
+#define GPIO_PUSH_PULL          0U
+#define GPIO_OPEN_DRAIN         1U
+
+// PUPDR
+#define GPIO_NO_PULL            0U
+#define GPIO_PULL_UP            1U
+#define GPIO_PULL_DOWN          2U
+
+typedef struct {
+    uint8_t port;       // GPIO_PORT_x
+    uint8_t pin;        // 0..15
+    uint8_t mode;       // GPIO_MODE_x
+    uint8_t otype;      // GPIO_PUSH_PULL / GPIO_OPEN_DRAIN
+    uint8_t pull;       // GPIO_NO_PULL / GPIO_PULL_UP / GPIO_PULL_DOWN
+    uint8_t af;         // alternate function 0..15 (GPIO_MODE_AF)
+} gpio_pin_t;
+
+// Inlined even at -O0, so RAMFUNC callers stay out of flash
+#define GPIO_INLINE     static inline __attribute__((always_inline))
+
+//-------------------------------------------------------------------------------------------
+//  Gpio_Port
+//  Register block of a port
+//-------------------------------------------------------------------------------------------
+GPIO_INLINE GPIO_TypeDef *Gpio_Port(uint32_t port) {
+    switch (port) {
+    case GPIO_PORT_A: return GPIOA;
+    case GPIO_PORT_B: return GPIOB;
+    case GPIO_PORT_C: return GPIOC;
+    case GPIO_PORT_D: return GPIOD;
+    default:          return GPIOH;
+    }
+}
+
+GPIO_INLINE void Gpio_Set(gpio_pin_t p) {
+    Gpio_Port(p.port)->BSRR = 1UL << p.pin;
+}
+
+GPIO_INLINE void Gpio_Clear(gpio_pin_t p) {
+    Gpio_Port(p.port)->BSRR = 1UL << (p.pin + 16U);
+}
+
+GPIO_INLINE void Gpio_Write(gpio_pin_t p, uint32_t level) {
+    Gpio_Port(p.port)->BSRR = level ? 1UL << p.pin : 1UL << (p.pin + 16U);
+}
+
+GPIO_INLINE void Gpio_Toggle(gpio_pin_t p) {
+    GPIO_TypeDef *port = Gpio_Port(p.port);
+    port->BSRR = (port->ODR & (1UL << p.pin)) ? 1UL << (p.pin + 16U) : 1UL << p.pin;
+}
+
+// Input level (IDR), 0 or 1
+GPIO_INLINE uint32_t Gpio_Read(gpio_pin_t p) {
+    return (Gpio_Port(p.port)->IDR >> p.pin) & 1UL;
+}
+
+#endif /* __STM32L476G_GPIO_H */
@@ -0,0 +1,79 @@
+/*
+ * irq_config.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_IRQ_CONFIG_H
+#define __STM32L476G_IRQ_CONFIG_H
+
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+// Preemption levels (4 bits, no sub-priority; lower number preempts higher).
+// Level 0 is kept free for anything that must preempt the stop path (faults only).
+#define IRQ_PRIO_PROTECTION     1   // button / emergency stop, debounce
+#define IRQ_PRIO_CONTROL        2   // ADC sample delivery
+#define IRQ_PRIO_COMMS          3   // telemetry / trace links
+#define IRQ_PRIO_HOUSEKEEPING   4   // SysTick, timebase overflow
+
+// Interrupt sources in the priority map, also the index into irq_latency[]
+enum {
+    IRQ_SLOT_BUTTON,        // EXTI15_10_IRQn
+    IRQ_SLOT_DEBOUNCE,      // TIM6_DAC_IRQn
+    IRQ_SLOT_ADC,           // ADC1_2_IRQn
+    IRQ_SLOT_TIMEBASE,      // TIM5_IRQn
+    IRQ_SLOT_SYSTICK,       // SysTick_IRQn
+    IRQ_SLOT_FRAME,         // TIM2_IRQn (LATENCY_MEASURE only, not probed)
+    IRQ_SLOT_COUNT
+};
+
+// Entry latency per source in CPU cycles, readable in the Expressions window.
+//   SysTick : measured on every tick from the counter (LOAD - VAL at entry).
+//   others  : measured by Irq_LatencyProbe(), which pends the IRQ by software while
+//             the system runs, so blocking by higher levels is included.
+typedef struct {
+    uint32_t samples;
+    uint32_t last_cycles;
+    uint32_t max_cycles;
+} irq_latency_t;
+
+extern irq_latency_t     irq_latency[IRQ_SLOT_COUNT];
+extern volatile uint32_t irq_probe_slot;     // slot + 1 while a probe is in flight
+extern volatile uint32_t irq_probe_stamp;    // TIM5->CNT when the probe was pended
+
+// Modular function to set priority grouping and the priority of every source.
+// Call first in main(), before any driver enables its interrupt.
+void Irq_Init(void);
+
+// Pend the next source (round robin) and time its entry. Call from the main loop.
+void Irq_LatencyProbe(void);
+
+// Record a latency sample (used by Irq_Entry).
+void Irq_Record(uint32_t slot, uint32_t cycles);
+
+// First statement of every handler in the map.
+static inline void Irq_Entry(uint32_t slot) {
+    if (slot == IRQ_SLOT_SYSTICK) {
+        Irq_Record(slot, SysTick->LOAD - SysTick->VAL);
+    }
+    else if (irq_probe_slot == slot + 1U) {
+        Irq_Record(slot, TIM5->CNT - irq_probe_stamp);
+        irq_probe_slot = 0;
+    }
+}
+
+// BASEPRI critical section: masks every source at 'prio' and below, leaves the more
+// urgent ones running. Returns the previous mask for Irq_Unlock().
+static inline uint32_t Irq_Lock(uint32_t prio) {
+    uint32_t old = __get_BASEPRI();
+    __set_BASEPRI_MAX(prio << (8U - __NVIC_PRIO_BITS));
+    return old;
+}
+
+static inline void Irq_Unlock(uint32_t old) {
+    __set_BASEPRI(old);
+}
+
+#endif /* __STM32L476G_IRQ_CONFIG_H */
@@ -0,0 +1,95 @@
+/*
+ * latency.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_LATENCY_H
+#define __STM32L476G_LATENCY_H
+
+#include "stm32l476xx.h"
+#include "ring_buffer.h"
+#include <stdint.h>
+
+// Set to 1 (e.g. -DLATENCY_MEASURE=1) for the input-to-output measurement mode.
+// With 0 the hooks below fold away and TIM2 keeps its update interrupt disabled.
+#ifndef LATENCY_MEASURE
+#define LATENCY_MEASURE  0
+#endif
+
+// Timeline of one PWM frame (all stamps are TIM5->CNT, 4 MHz):
+//
+//   frame  : TIM2 update event, which also starts the ADC conversion (TRGO)
+//   sample : ADC1_2_IRQHandler takes the result
+//   commit : Control_Step writes CCR1 (preloaded)
+//   apply  : first TIM2 update after the commit, where the new pulse edge goes out
+//
+// Per frame (us):
+//   acquire = sample - frame     conversion + interrupt delivery
+//   compute = commit - sample    queue + Control_Task + Control_Step
+//   total   = apply  - frame     input sampled -> TIM2_CH1 edge reflects it
+typedef struct {
+    uint32_t acquire_us;
+    uint32_t compute_us;
+    uint32_t total_us;
+} latency_frame_t;
+
+// Frames from TIM2_IRQHandler (producer) to Latency_Report (consumer)
+RING_BUFFER_DEFINE(latency_frames, latency_frame_t, 64)
+extern latency_frames_t latency_frames;
+
+typedef struct {
+    uint32_t p50;
+    uint32_t p99;
+    uint32_t max;
+} latency_dist_t;
+
+// Distributions over the frames drained by the last Latency_Report(), in us.
+// Jitter of a stage = p99 - p50.
+typedef struct {
+    uint32_t       frames;          // frames in this window
+    uint32_t       late;            // frames whose commit missed the next update (total over
+                                    // 1.5 PWM periods; on time it is one period)
+    latency_dist_t acquire;
+    latency_dist_t compute;
+    latency_dist_t total;
+} latency_report_t;
+
+extern volatile latency_report_t latency_report;
+
+// Stamps of the frame in progress (written by the hooks below)
+extern volatile uint32_t latency_frame_stamp;
+extern volatile uint32_t latency_sample_frame;
+extern volatile uint32_t latency_sample_stamp;
+extern volatile uint32_t latency_pending_frame;
+extern volatile uint32_t latency_pending_sample;
+extern volatile uint32_t latency_pending_commit;
+extern volatile uint8_t  latency_pending_valid;
+
+// Modular function to enable the TIM2 update interrupt. Call after PWM_Init().
+void Latency_Init(void);
+
+// Reduce the frames collected since the last call to p50/p99/max. Main context.
+void Latency_Report(void);
+
+// Hook for ADC1_2_IRQHandler, when the sample is taken.
+static inline void Latency_Sample(void) {
+    if (LATENCY_MEASURE) {
+        latency_sample_frame = latency_frame_stamp;
+        latency_sample_stamp = TIM5->CNT;
+    }
+}
+
+// Hook for Control_Step, right after the CCR1 write. Must run with TIM2_IRQn masked
+// (Control_Step holds the BASEPRI lock).
+static inline void Latency_Commit(void) {
+    if (LATENCY_MEASURE) {
+        latency_pending_frame  = latency_sample_frame;
+        latency_pending_sample = latency_sample_stamp;
+        latency_pending_commit = TIM5->CNT;
+        latency_pending_valid  = 1;
+    }
+}
+
+#endif /* __STM32L476G_LATENCY_H */
@@ -0,0 +1,34 @@
+/*
+ * mem_sections.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_MEM_SECTIONS_H
+#define __STM32L476G_MEM_SECTIONS_H
+
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+// Place a function in SRAM2 (0x10000000). SRAM2 is fetched over the I-Code/D-Code
+// buses with zero wait states at any SYSCLK, so ISR timing does not depend on the
+// flash latency or the ART cache. Reset_Handler copies the code from flash.
+// Calls between SRAM2 and flash are out of BL range; the linker inserts veneers.
+#define RAMFUNC    __attribute__((section(".ramfunc"), noinline))
+
+// Place a variable in SRAM2 (initialized from flash by Reset_Handler).
+#define FASTDATA   __attribute__((section(".fastdata")))
+
+// Set to 1 to run from a copy of the vector table in SRAM2 (see main()).
+#ifndef RELOCATE_VECTOR_TABLE
+#define RELOCATE_VECTOR_TABLE  0
+#endif
+
+// Cortex-M4 system exceptions + STM32L476 IRQs (WWDG_IRQn .. FPU_IRQn)
+#define VECTOR_TABLE_ENTRIES   (16 + FPU_IRQn + 1)
+
+// Modular function to copy the flash vector table into SRAM2 and point SCB->VTOR at it.
+void VectorTable_RelocateToSRAM2(void);
+
+#endif /* __STM32L476G_MEM_SECTIONS_H */
@@ -0,0 +1,116 @@
+/*
+ * param_store.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_PARAM_STORE_H
+#define __STM32L476G_PARAM_STORE_H
+
+#include "arming.h"
+#include "control.h"
+#include "tasks.h"
+#include <stdint.h>
+
+// Tunable parameters, kept in the last two flash pages of bank 2 so a fielded unit can
+// be retuned without reflashing the firmware.
+//
+//   - Runtime reads come from a RAM shadow: Param_Get() is one load.
+//   - Flash layout (each page, 2 KB = 256 double words):
+//
+//       dword 0          header   lo = PARAM_MAGIC, hi = generation (programmed last)
+//       dword 1 + k*L    lane k   records of parameter k, oldest first, L slots
+//
+//     A record is one 64-bit double word, programmed in a single operation:
+//       lo = value, hi = id | PARAM_RECORD_TAG << 8 | CRC-16 << 16.
+//   - Param_Set() appends the record to the parameter's lane. When the lane is full the
+//     current values are copied to the other page, whose header is programmed last with
+//     the next generation: until then the old page stays the valid one. The two pages
+//     take turns, so both wear evenly. A record that fails to program also moves the
+//     values to the other page, so no lane has a hole.
+//   - Boot load reads the two headers and binary-searches each lane for its last record:
+//     2 + PARAM_COUNT * (log2(L) + 2) double-word reads, whatever the history (plus one
+//     per torn record).
+//   - A record torn by a reset fails its CRC and the previous one is used. A torn double
+//     word may also read with a double ECC error, which raises the NMI: NMI_Handler
+//     clears it and the read counts as a bad record (a bad header: the other page is
+//     used). The next erase of the page clears it for good.
+//
+// Bank 2 is written while the code runs from bank 1 (read-while-write), but a page erase
+// still blocks the caller for ~22 ms: Param_Task only commits while DISARMED.
+
+//-------------------------------------------------------------------------------------------
+//  Parameters
+//  X(name, default, min, max, step)
+//-------------------------------------------------------------------------------------------
+#define PARAM_TABLE(X)                                                                      \
+    X(ARMING_TIME_MS,   ARMING_TIME_MS,         1000,   4000,   1)      /* timer wheel: 4.096 s */ \
+    X(HEARTBEAT_MS,     TASK_HEARTBEAT_TOGGLE_MS, TASK_HEARTBEAT_PERIOD_MS, 2000,           \
+                                                TASK_HEARTBEAT_PERIOD_MS)                   \
+    X(PULSE_MIN_US,     CONTROL_PULSE_MIN_US,   900,    1200,   1)                          \
+    X(PULSE_MAX_US,     CONTROL_PULSE_MAX_US,   1800,   2100,   1)
+
+#define PARAM_ENUM_(name, def, min, max, step)  PARAM_##name,
+enum {
+    PARAM_TABLE(PARAM_ENUM_)
+    PARAM_COUNT
+};
+
+//-------------------------------------------------------------------------------------------
+//  Flash
+//-------------------------------------------------------------------------------------------
+#define PARAM_PAGE_SIZE         2048U
+#define PARAM_PAGE_DWORDS       (PARAM_PAGE_SIZE / 8U)
+#define PARAM_FLASH_OFFSET      0xFF000U    // from FLASH_BASE: 0x080FF000, see the .ld
+#define PARAM_FLASH_PAGE        254U        // bank 2 page number of the first page
+#define PARAM_BANK_SIZE         0x80000U    // bank 2 starts 512 KB from FLASH_BASE
+#define PARAM_LANE_SLOTS        ((PARAM_PAGE_DWORDS - 1U) / PARAM_COUNT)
+
+#define PARAM_MAGIC             0x314D5250U // "PRM1"
+#define PARAM_RECORD_TAG        0xA5U
+
+_Static_assert(PARAM_LANE_SLOTS >= 2U, "too many parameters for one page");
+
+// Statistics, readable in the Expressions window
+typedef struct {
+    uint32_t generation;    // header of the active page (0: blank, defaults)
+    uint32_t boot_reads;    // double words read by Param_Init()
+    uint32_t bad_records;   // records skipped at boot (CRC, ECC, id or range)
+    uint32_t ecc_errors;    // double ECC errors in the store (NMI)
+    uint32_t writes;        // records programmed
+    uint32_t compactions;   // page switches (erases)
+    uint32_t errors;        // rejected values and flash errors
+} param_stats_t;
+
+// Change request from the debugger: write id and value, then pending = 1. Param_Task
+// commits it while DISARMED and sets status (1 = stored, 0 = rejected).
+typedef struct {
+    uint32_t id;
+    uint32_t value;
+    uint32_t pending;
+    uint32_t status;
+} param_request_t;
+
+extern uint32_t                 param_shadow[PARAM_COUNT];
+extern volatile uint32_t        param_version;      // incremented by every change
+extern param_stats_t            param_stats;
+extern volatile param_request_t param_request;
+
+// Current value of a parameter (RAM shadow)
+static inline uint32_t Param_Get(uint32_t id) {
+    return param_shadow[id];
+}
+
+// Modular function to load the shadow from flash (defaults for a blank store).
+// Call early in main(), before the modules that read parameters.
+void Param_Init(void);
+
+// Modular function to validate, store and apply a value.
+// Returns 1 if stored, 0 if out of range or the flash operation failed.
+uint8_t Param_Set(uint32_t id, uint32_t value);
+
+// Task: commit a pending param_request (while DISARMED).
+void Param_Task(void);
+
+#endif /* __STM32L476G_PARAM_STORE_H */
@@ -0,0 +1,52 @@
+/*
+ * power.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_POWER_H
+#define __STM32L476G_POWER_H
+
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+// Set to 1 to enter Stop 2 while DISARMED instead of Sleep.
+// TIM2 is halted in Stop 2, so the ESC stops receiving the 1000 us pulse.
+// Only enable this when the ESC is unpowered or treats signal loss as "stop".
+#ifndef POWER_STOP2_WHEN_DISARMED
+#define POWER_STOP2_WHEN_DISARMED  0
+#endif
+
+// Low-power statistics, readable in the Expressions window.
+//   awake_cycles : DWT cycle count accumulated while the core was running
+//                  (CYCCNT is halted while the core clock is gated in Sleep/Stop)
+//   wake_cycles_*: Sleep wake-up latency, from the SysTick event that woke the core to
+//                  the first instruction after WFI, in core cycles (4 MHz: 0.25 us).
+//                  SysTick's own counter gives the time since its wrap; DWT cannot,
+//                  it stops in Sleep. Only wake-ups by SysTick are measured.
+//
+// Stop 2 wake-up latency is not measured: no clock the firmware could read runs in
+// Stop 2 (SysTick, TIM5 and DWT all stop), so it needs a GPIO and a scope. Current draw
+// per mode is not measured either: it needs the Nucleo IDD jumper and an ammeter.
+typedef struct {
+    uint32_t sleep_entries;
+    uint32_t stop2_entries;
+    uint32_t awake_cycles;
+    uint32_t wake_samples;
+    uint32_t wake_cycles_min;
+    uint32_t wake_cycles_max;
+    uint32_t wake_cycles_last;
+} power_stats_t;
+
+extern volatile power_stats_t power_stats;
+
+// Modular function to enable the PWR clock and the DWT cycle counter used for statistics.
+void Power_Init(void);
+
+// Modular function to idle the core until the next interrupt.
+//   ARMED / ARMING : Sleep (WFI); SysTick, TIM2, ADC and EXTI keep running.
+//   DISARMED       : Stop 2 if POWER_STOP2_WHEN_DISARMED, woken by EXTI13 (button).
+void Power_Idle(void);
+
+#endif /* __STM32L476G_POWER_H */
@@ -0,0 +1,77 @@
+/*
+ * profile.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_PROFILE_H
+#define __STM32L476G_PROFILE_H
+
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+// Set to 1 (e.g. -DPROFILE_ENABLE=1) to build the probes in. With 0 the
+// PROFILE_BEGIN/PROFILE_END markers expand to nothing, Profile_Init() is an empty inline
+// and neither the probe table nor the functions are compiled.
+#ifndef PROFILE_ENABLE
+#define PROFILE_ENABLE  0
+#endif
+
+// Probe IDs
+enum {
+    PROF_ADC_READ,          // ADC_Read10bit()
+    PROF_PWM_SET,           // PWM_SetPulse_us()
+    PROF_CONTROL_STEP,      // Control_Step()
+    PROF_ISR_SYSTICK,       // SysTick_Handler()
+    PROF_ISR_BUTTON,        // EXTI15_10_IRQHandler()
+    PROF_ISR_ADC,           // ADC1_2_IRQHandler()
+    PROF_COUNT
+};
+
+// log2 histogram: bin n counts durations in [2^n, 2^(n+1)) cycles (bin 0 also holds 0)
+#define PROFILE_BINS    32
+
+// Per-probe statistics in CPU cycles (DWT->CYCCNT), readable in the Expressions window.
+// mean = sum / count (see Profile_Mean()).
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t hist[PROFILE_BINS];
+} profile_probe_t;
+
+#if PROFILE_ENABLE
+
+extern profile_probe_t profile_probes[PROF_COUNT];
+
+#define PROFILE_BEGIN(id)   uint32_t prof_start_##id = DWT->CYCCNT
+#define PROFILE_END(id)     Profile_Record((id), DWT->CYCCNT - prof_start_##id)
+
+// Modular function to start the DWT cycle counter and clear all probes.
+void Profile_Init(void);
+
+// Clear all probes (e.g. after changing a test condition).
+void Profile_Reset(void);
+
+// Add one measurement to probe 'id'. Safe from any context.
+void Profile_Record(uint32_t id, uint32_t cycles);
+
+// Mean duration of probe 'id' in cycles (0 if never hit).
+uint32_t Profile_Mean(uint32_t id);
+
+#else
+
+#define PROFILE_BEGIN(id)
+#define PROFILE_END(id)
+
+static inline void Profile_Init(void) {
+}
+
+static inline void Profile_Reset(void) {
+}
+
+#endif /* PROFILE_ENABLE */
+
+#endif /* __STM32L476G_PROFILE_H */
@@ -0,0 +1,89 @@
+/*
+ * ring_buffer.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_RING_BUFFER_H
+#define __STM32L476G_RING_BUFFER_H
+
+#include <stdint.h>
+
+// Lock-free single-producer / single-consumer ring buffer (header-only).
+//
+//   RING_BUFFER_DEFINE(name, type, size) declares the type 'name_t' and the inline
+//   functions name_push(), name_pop(), name_count(), name_peek_span(), name_consume().
+//
+//   - 'size' must be a power of two; head/tail run freely and are masked on access,
+//     so all 'size' slots are usable and wrap-around is a single AND.
+//   - Exactly one context may push (e.g. an ISR) and exactly one may pop (e.g. a task).
+//   - The producer publishes 'head' with a release store after writing the slot and the
+//     consumer reads it with an acquire load (DMB on Cortex-M4), so the slot contents are
+//     visible before the index, to the other context and to the DMA.
+//   - The storage is 32-byte aligned and contiguous; name_peek_span() hands out the
+//     longest contiguous readable run, e.g. as a DMA source, and name_consume() frees it.
+//
+// Example:
+//   RING_BUFFER_DEFINE(button_events, uint8_t, 16)
+//   static button_events_t button_queue;
+//   ISR : button_events_push(&button_queue, ev);
+//   Task: while (button_events_pop(&button_queue, &ev)) { ... }
+
+#define RING_LOAD_ACQUIRE(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define RING_STORE_RELEASE(p, v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define RING_LOAD_RELAXED(p)        __atomic_load_n((p), __ATOMIC_RELAXED)
+
+#define RING_BUFFER_DEFINE(name, type, size)                                                \
+                                                                                            \
+typedef char name##_size_is_power_of_two[(((size) & ((size) - 1)) == 0 && (size) > 0) ? 1 : -1]; \
+                                                                                            \
+typedef struct {                                                                            \
+    type     buf[(size)] __attribute__((aligned(32)));                                      \
+    uint32_t head;      /* written by the producer only */                                 \
+    uint32_t tail;      /* written by the consumer only */                                 \
+    uint32_t dropped;   /* pushes rejected because the ring was full */                    \
+} name##_t;                                                                                 \
+                                                                                            \
+static inline uint32_t name##_count(name##_t *rb) {                                         \
+    return RING_LOAD_ACQUIRE(&rb->head) - RING_LOAD_ACQUIRE(&rb->tail);                     \
+}                                                                                           \
+                                                                                            \
+/* Producer side. Returns 0 (and counts a drop) if the ring is full. */                     \
+static inline uint8_t name##_push(name##_t *rb, type item) {                                \
+    uint32_t head = RING_LOAD_RELAXED(&rb->head);                                           \
+    if (head - RING_LOAD_ACQUIRE(&rb->tail) >= (size)) {                                    \
+        rb->dropped++;                                                                      \
+        return 0;                                                                           \
+    }                                                                                       \
+    rb->buf[head & ((size) - 1)] = item;                                                    \
+    RING_STORE_RELEASE(&rb->head, head + 1);                                                \
+    return 1;                                                                               \
+}                                                                                           \
+                                                                                            \
+/* Consumer side. Returns 0 if the ring is empty. */                                        \
+static inline uint8_t name##_pop(name##_t *rb, type *item) {                                \
+    uint32_t tail = RING_LOAD_RELAXED(&rb->tail);                                           \
+    if (RING_LOAD_ACQUIRE(&rb->head) == tail) {                                             \
+        return 0;                                                                           \
+    }                                                                                       \
+    *item = rb->buf[tail & ((size) - 1)];                                                   \
+    RING_STORE_RELEASE(&rb->tail, tail + 1);                                                \
+    return 1;                                                                               \
+}                                                                                           \
+                                                                                            \
+/* Consumer side: longest contiguous run of unread items (e.g. for a DMA transfer). */      \
+static inline uint32_t name##_peek_span(name##_t *rb, type **first) {                       \
+    uint32_t tail  = RING_LOAD_RELAXED(&rb->tail);                                          \
+    uint32_t count = RING_LOAD_ACQUIRE(&rb->head) - tail;                                   \
+    uint32_t index = tail & ((size) - 1);                                                   \
+    *first = &rb->buf[index];                                                               \
+    return (count < (size) - index) ? count : (size) - index;                               \
+}                                                                                           \
+                                                                                            \
+/* Consumer side: release 'n' items returned by peek_span once they are processed. */       \
+static inline void name##_consume(name##_t *rb, uint32_t n) {                               \
+    RING_STORE_RELEASE(&rb->tail, RING_LOAD_RELAXED(&rb->tail) + n);                        \
+}
+
+#endif /* __STM32L476G_RING_BUFFER_H */
@@ -0,0 +1,56 @@
+/*
+ * scheduler.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_SCHEDULER_H
+#define __STM32L476G_SCHEDULER_H
+
+#include <stdint.h>
+
+// Task body. Runs to completion in the main loop (cooperative, never from an ISR).
+typedef void (*task_fn_t)(void);
+
+// Static task descriptor. The table is sorted by period (rate-monotonic):
+// a lower index means a higher rate and a higher priority.
+typedef struct {
+    const char *name;
+    task_fn_t   run;
+    uint16_t    period_ms;      // release period in SysTick ticks (1 ms)
+    uint16_t    offset_ms;      // first release, spreads tasks across ticks
+    uint16_t    deadline_ms;    // must finish within this many ms of its release
+} task_t;
+
+// Per-task accounting, readable in the Expressions window.
+//   overruns : instances that finished after their deadline
+//   skipped  : releases dropped because the task was still late by a full period
+typedef struct {
+    uint32_t runs;
+    uint32_t overruns;
+    uint32_t skipped;
+    uint32_t max_lateness_ms;   // release -> start
+    uint32_t max_exec_cycles;   // start -> finish (TIM5 cycles)
+} task_stats_t;
+
+// Task table and size, defined by the application (tasks.c)
+extern const task_t   task_table[];
+extern const uint32_t task_count;
+
+extern volatile uint32_t scheduler_ticks;
+extern task_stats_t      task_stats[];
+
+// Modular function to reset statistics and compute first releases.
+void Scheduler_Init(void);
+
+// Advance time by one tick. The only thing SysTick_Handler does.
+void Scheduler_Tick(void);
+
+// Run every released task, highest rate first. Returns when nothing is due.
+void Scheduler_Run(void);
+
+// Returns 1 if at least one task is released and waiting to run.
+uint8_t Scheduler_Pending(void);
+
+#endif /* __STM32L476G_SCHEDULER_H */
@@ -0,0 +1,61 @@
+/*
+ * stack_monitor.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_STACK_MONITOR_H
+#define __STM32L476G_STACK_MONITOR_H
+
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+// Main stack (MSP) usage. main() and every ISR run on the MSP, so its high-water mark
+// includes the deepest interrupt nesting seen so far.
+//
+//   ##########################################################
+//   #  heap ...  # guard #        free        #     used     #
+//   ##########################################################
+//                ^-- _sstack                     _estack --^
+//
+//   - Reset_Handler paints [_sstack, _estack) with STACK_PAINT_WORD before anything runs.
+//   - StackMonitor_HighWater() finds the lowest word that was ever overwritten.
+//   - With STACK_MPU_GUARD, the bottom _Stack_Guard_Size bytes are a no-access MPU
+//     region: an overflow faults instead of running into the heap, and the fault
+//     handler forces the ESC stop pulse.
+
+// Must match the value used by Reset_Handler (startup_stm32l476rgtx.s)
+#define STACK_PAINT_WORD    0xA5A5A5A5U
+
+// Set to 0 to leave the MPU off.
+#ifndef STACK_MPU_GUARD
+#define STACK_MPU_GUARD     1
+#endif
+
+#define STACK_GUARD_REGION  0U      // MPU region number
+
+// Fault status captured by the fault handler, for the debugger
+typedef struct {
+    uint32_t cfsr;          // SCB->CFSR (MSTKERR / DACCVIOL for a guard hit)
+    uint32_t mmfar;         // SCB->MMFAR (faulting address when MMARVALID)
+    uint32_t sp;            // MSP at fault entry
+} stack_fault_t;
+
+extern volatile stack_fault_t stack_fault;
+
+// Modular function to program the MPU guard region below the stack and enable the
+// MemManage fault. Call early in main().
+void StackMonitor_Init(void);
+
+// Peak stack use since reset, in bytes (scans the painted area).
+uint32_t StackMonitor_HighWater(void);
+
+// Usable stack size in bytes (reservation minus the guard band).
+uint32_t StackMonitor_Size(void);
+
+// Last resort for any fault: hold the ESC at the stop pulse and halt, with the cause in
+// stack_fault. Called by the fault handlers (and NMI_Handler, param_store.c).
+void Fault_Stop(void) __attribute__((noreturn));
+
+#endif /* __STM32L476G_STACK_MONITOR_H */
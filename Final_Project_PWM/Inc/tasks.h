@@ -0,0 +1,57 @@
+/*
+ * tasks.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_TASKS_H
+#define __STM32L476G_TASKS_H
+
+#include <stdint.h>
+
+// Task table indices, in rate-monotonic order (fastest first)
+enum {
+    TASK_CONTROL,       // 1 kHz : apply the latest ADC sample to the PWM output
+    TASK_TIMERS,        // 1 kHz : advance the software timer wheel
+    TASK_ARMING,        // 1 kHz : process arm/disarm events (arming.c)
+    TASK_TRACE,         // 100 Hz: drain the event trace over the UART (trace.c)
+    TASK_HEARTBEAT,     // 10 Hz : ARMED heartbeat LED
+    TASK_PARAMS,        // 10 Hz : commit a parameter change request (param_store.c)
+    TASK_TELEMETRY,     // 1 Hz  : snapshot for the debugger / telemetry link
+    TASK_COUNT
+};
+
+#define TASK_CONTROL_PERIOD_MS      1
+#define TASK_TIMERS_PERIOD_MS       1
+#define TASK_ARMING_PERIOD_MS       1
+#define TASK_TRACE_PERIOD_MS        10
+#define TASK_HEARTBEAT_PERIOD_MS    100     // heartbeat resolution
+#define TASK_PARAMS_PERIOD_MS       100
+#define TASK_TELEMETRY_PERIOD_MS    1000
+
+#define TASK_HEARTBEAT_TOGGLE_MS    500     // default of PARAM_HEARTBEAT_MS (param_store.h)
+
+// Telemetry snapshot, refreshed once per second by Telemetry_Task().
+typedef struct {
+    uint32_t uptime_ms;
+    uint16_t throttle;          // last ADC sample (0..1023)
+    uint16_t pulse_counts;      // last CCR1 value (20 us per count)
+    uint8_t  state;             // ARMING_STATE_*
+    uint32_t task_overruns;     // sum over all tasks
+    uint32_t awake_cycles;      // from power_stats
+    uint32_t button_presses;    // drained from button_events
+    uint32_t last_press_us;
+    uint8_t  last_gesture;      // BUTTON_EVENT_SHORT / LONG / DOUBLE
+    uint32_t stack_high_water;  // peak MSP use in bytes (of stack_size)
+    uint32_t stack_size;
+} telemetry_t;
+
+extern volatile telemetry_t telemetry;
+
+void Control_Task(void);
+void Timers_Task(void);
+void Heartbeat_Task(void);
+void Telemetry_Task(void);
+
+#endif /* __STM32L476G_TASKS_H */
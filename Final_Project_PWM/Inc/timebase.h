@@ -0,0 +1,34 @@
+/*
+ * timebase.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_TIMEBASE_H
+#define __STM32L476G_TIMEBASE_H
+
+#include "stm32l476xx.h"
+#include "board_config.h"
+#include <stdint.h>
+
+// TIM5 runs from PCLK1 = HCLK = 4 MHz (MSI, APB1 prescaler 1), so one timer count
+// is one CPU cycle.
+#define TIMEBASE_CLOCK_HZ        BOARD_SYSCLK_HZ
+#define TIMEBASE_CYCLES_PER_US   (TIMEBASE_CLOCK_HZ / 1000000U)
+
+// Modular function to start the free-running 32-bit TIM5 counter and its overflow interrupt.
+void Timebase_Init(void);
+
+// Monotonic time since Timebase_Init() in CPU cycles (64-bit, never wraps in practice).
+// Lock-free and safe to call from any context, including with interrupts masked.
+// TIM5 keeps counting in Sleep; it is halted in Stop 2.
+uint64_t now_cycles(void);
+
+// Monotonic time since Timebase_Init() in microseconds.
+uint64_t now_us(void);
+
+// TIM5 Interrupt Handler: extends the 32-bit counter on overflow
+void TIM5_IRQHandler(void);
+
+#endif /* __STM32L476G_TIMEBASE_H */
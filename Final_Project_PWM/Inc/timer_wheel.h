@@ -0,0 +1,52 @@
+/*
+ * timer_wheel.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_TIMER_WHEEL_H
+#define __STM32L476G_TIMER_WHEEL_H
+
+#include <stdint.h>
+
+// Hierarchical timing wheel: 3 levels of 64 slots.
+//   level 0 : 1 ms slots    -> delays up to 64 ms expire straight from their slot
+//   level 1 : 64 ms slots   -> up to 4.096 s, cascaded into level 0 every 64 ticks
+//   level 2 : 4.096 s slots -> up to 262 s, cascaded into level 1 every 4096 ticks
+// Longer delays are parked in the farthest slot and re-sorted when it cascades.
+#define TIMER_WHEEL_BITS        6
+#define TIMER_WHEEL_SLOTS       (1U << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_LEVELS      3
+
+typedef struct soft_timer soft_timer_t;
+typedef void (*soft_timer_fn_t)(soft_timer_t *timer);
+
+// Intrusive timer node, owned by the caller (usually a static variable).
+struct soft_timer {
+    soft_timer_t   *next;
+    soft_timer_t  **pprev;      // NULL when the timer is not armed
+    uint32_t        expires;    // absolute tick
+    uint32_t        period;     // 0 = one-shot
+    soft_timer_fn_t callback;
+};
+
+// Modular function to empty the wheel and set its current tick.
+void TimerWheel_Init(uint32_t now);
+
+// Arm 'timer' to fire 'delay_ms' ticks from now, then every 'period_ms' (0 = once).
+// Re-arming an active timer moves it. O(1).
+void TimerWheel_Start(soft_timer_t *timer, uint32_t delay_ms, uint32_t period_ms,
+                      soft_timer_fn_t callback);
+
+// Disarm 'timer' if active. O(1).
+void TimerWheel_Stop(soft_timer_t *timer);
+
+// Returns 1 if 'timer' is armed.
+uint8_t TimerWheel_IsActive(const soft_timer_t *timer);
+
+// Process every tick up to and including 'now', running expired callbacks.
+// All TimerWheel_* calls must come from the same (main loop) context.
+void TimerWheel_Advance(uint32_t now);
+
+#endif /* __STM32L476G_TIMER_WHEEL_H */
@@ -0,0 +1,104 @@
+/*
+ * trace.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+
+#ifndef __STM32L476G_TRACE_H
+#define __STM32L476G_TRACE_H
+
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+// Binary event trace (flight recorder).
+//
+//   Trace_Record(id, arg) stores one 8-byte record {TIM5 stamp, id, arg} in a circular
+//   buffer: one atomic increment and three stores, from any context (ISR or task).
+//   When the buffer is full the oldest records are overwritten.
+//
+//   Read it out either way:
+//   - Debugger: dump the whole 'trace_buffer' object, e.g. in GDB
+//       dump binary value trace.bin trace_buffer
+//   - UART: with TRACE_UART = 1, Trace_Task streams the header once and then the
+//     records over USART2 TX (PA2, ST-LINK virtual COM port) using DMA1 channel 7.
+//
+//   Tools/trace_decode turns either capture into a Chrome trace (chrome://tracing,
+//   ui.perfetto.dev) or a text timeline.
+//
+//   Record and replay: ADC_SAMPLE and BUTTON_EDGE records are the inputs of the control
+//   path. Host/firmware_replay feeds them back through the firmware on the simulated
+//   board and prints the PWM command sequence, so a field capture can be reproduced and
+//   two firmware versions compared with diff. The replay starts at reset: use a UART
+//   capture from power-up, or a debugger dump taken before the ring wrapped.
+
+// Set to 0 to compile every Trace_Record() out.
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE        1
+#endif
+
+// Set to 1 to stream the trace over USART2 (PA2 becomes the UART TX pin).
+#ifndef TRACE_UART
+#define TRACE_UART          0
+#endif
+
+#define TRACE_UART_BAUD     115200U
+#define TRACE_RECORDS       256U            // power of two (2 KB)
+#define TRACE_DRAIN_MAX     64U             // records per DMA transfer (512 bytes, 45 ms)
+#define TRACE_MAGIC         0x45435254U     // "TRCE" in memory
+#define TRACE_VERSION       1U
+
+// Record IDs (keep in step with Tools/trace_decode)
+enum {
+    TRACE_ID_LOST = 0,          // arg: records overwritten before the UART drain sent them
+    TRACE_ID_BUTTON_EDGE,       // arg: 1 = press, 0 = release
+    TRACE_ID_ARM_STATE,         // arg: new ARMING_STATE_*
+    TRACE_ID_ADC_SAMPLE,        // arg: 10-bit sample
+    TRACE_ID_PWM_COMMIT,        // arg: pulse width in us
+    TRACE_ID_TASK_OVERRUN,      // arg: task index (TASK_*)
+    TRACE_ID_COUNT
+};
+
+typedef struct {
+    uint32_t ts;                // TIM5->CNT (4 MHz, wraps every 1073 s)
+    uint16_t id;                // TRACE_ID_*
+    uint16_t arg;
+} trace_record_t;
+
+typedef struct {
+    uint32_t magic;             // TRACE_MAGIC
+    uint16_t version;           // TRACE_VERSION
+    uint16_t record_size;       // sizeof(trace_record_t)
+    uint32_t capacity;          // TRACE_RECORDS
+    uint32_t clock_hz;          // stamp clock
+    uint32_t head;              // records written so far; next slot = head % capacity
+    uint32_t lost;              // records overwritten before the UART drain sent them
+} trace_header_t;
+
+typedef struct {
+    trace_header_t header;
+    trace_record_t records[TRACE_RECORDS];
+} trace_buffer_t;
+
+extern trace_buffer_t trace_buffer;
+
+// Modular function to initialize the trace buffer (and USART2 + DMA when TRACE_UART).
+// Call after Timebase_Init(), before the first event.
+void Trace_Init(void);
+
+// Task: start the next DMA transfer when the previous one has completed (TRACE_UART).
+void Trace_Task(void);
+
+// Record one event.
+static inline void Trace_Record(uint16_t id, uint16_t arg) {
+    if (TRACE_ENABLE) {
+        uint32_t        i = __atomic_fetch_add(&trace_buffer.header.head, 1U, __ATOMIC_RELAXED);
+        trace_record_t *r = &trace_buffer.records[i & (TRACE_RECORDS - 1U)];
+
+        r->ts  = TIM5->CNT;
+        r->id  = id;
+        r->arg = arg;
+    }
+}
+
+#endif /* __STM32L476G_TRACE_H */
@@ -0,0 +1,130 @@
+#
+# firmware_keywords.py
+#
+#  Created on: Oct 19, 2026
+#      Author: Elias Asami, Milton Salazar
+#
+# Robot Framework keywords for firmware.robot: drive the inputs of the Renode platform
+# (stm32l476rg.repl) and measure its outputs, in virtual time.
+#
+# Time advances in steps of STEP_MS. At every 20 ms frame boundary the keywords complete
+# one ADC conversion and raise the ADC1_2 interrupt, standing in for the TIM2 TRGO
+# trigger the platform does not model.
+
+from robot.libraries.BuiltIn import BuiltIn
+
+STEP_MS = 10
+FRAME_MS = 20
+CLOCK_HZ = 4000000
+
+ADC1_BASE = 0x50040000
+ADC_INPUT_MV = ADC1_BASE + 0xF0
+ADC_TRIGGER = ADC1_BASE + 0xF4
+ADC1_2_IRQ = 18
+
+TIM2_BASE = 0x40000000
+TIM2_PSC = TIM2_BASE + 0x28
+TIM2_ARR = TIM2_BASE + 0x2C
+TIM2_CCR1 = TIM2_BASE + 0x34
+
+_elapsed_ms = 0
+
+
+def _monitor(command):
+    return BuiltIn().run_keyword('Execute Command', command)
+
+
+def _read32(address):
+    return int(_monitor('sysbus ReadDoubleWord 0x%08X' % address).strip(), 0)
+
+
+def _write32(address, value):
+    _monitor('sysbus WriteDoubleWord 0x%08X %d' % (address, value))
+
+
+def _step():
+    global _elapsed_ms
+    _monitor('emulation RunFor "00:00:00.%06d"' % (STEP_MS * 1000))
+    _elapsed_ms += STEP_MS
+    if _elapsed_ms % FRAME_MS == 0:
+        _write32(ADC_TRIGGER, 1)
+        _monitor('sysbus.nvic OnGPIO %d true' % ADC1_2_IRQ)
+        _monitor('sysbus.nvic OnGPIO %d false' % ADC1_2_IRQ)
+
+
+def _led():
+    return 'True' in _monitor('sysbus.gpioPortA.led State')
+
+
+#-------------------------------------------------------------------------------------------
+#  Inputs
+#-------------------------------------------------------------------------------------------
+def set_throttle_millivolts(mv):
+    """Voltage on PC0 for the following conversions."""
+    _write32(ADC_INPUT_MV, int(mv))
+
+
+def run_for_ms(ms):
+    """Advance virtual time, with one ADC conversion per frame."""
+    for _ in range(int(ms) // STEP_MS):
+        _step()
+
+
+def press_button(hold_ms=80):
+    """Press B1 (PC13 low), hold it, release it."""
+    _monitor('sysbus.gpioPortC.button Press')
+    run_for_ms(hold_ms)
+    _monitor('sysbus.gpioPortC.button Release')
+    run_for_ms(STEP_MS)
+
+
+#-------------------------------------------------------------------------------------------
+#  Outputs
+#-------------------------------------------------------------------------------------------
+def frame_period_us():
+    """TIM2 frame length from PSC and ARR."""
+    return (_read32(TIM2_ARR) + 1) * (_read32(TIM2_PSC) + 1) * 1000000 // CLOCK_HZ
+
+
+def pulse_width_us():
+    """Pulse of the next TIM2 frame (CCR1 is preloaded)."""
+    return _read32(TIM2_CCR1) * (_read32(TIM2_PSC) + 1) * 1000000 // CLOCK_HZ
+
+
+def led_toggle_intervals_ms(duration_ms):
+    """Time between LD2 (PA5) changes over the next 'duration_ms', at STEP_MS resolution."""
+    intervals, last, state = [], None, _led()
+    for t in range(STEP_MS, int(duration_ms) + STEP_MS, STEP_MS):
+        _step()
+        now = _led()
+        if now != state:
+            if last is not None:
+                intervals.append(t - last)
+            last, state = t, now
+    return intervals
+
+
+def ms_until_pulse_above(us, limit_ms):
+    """Virtual time until the committed pulse exceeds 'us' (fails after 'limit_ms')."""
+    for t in range(STEP_MS, int(limit_ms) + STEP_MS, STEP_MS):
+        _step()
+        if pulse_width_us() > int(us):
+            return t
+    raise AssertionError('pulse still at or below %s us after %s ms' % (us, limit_ms))
+
+
+#-------------------------------------------------------------------------------------------
+#  Checks
+#-------------------------------------------------------------------------------------------
+def should_be_within(value, expected, tolerance):
+    value, expected, tolerance = float(value), float(expected), float(tolerance)
+    if abs(value - expected) > tolerance:
+        raise AssertionError('%g is not within %g of %g' % (value, tolerance, expected))
+
+
+def intervals_should_be(intervals, expected_ms, tolerance_ms, minimum=2):
+    """Every LED toggle interval within tolerance of 'expected_ms'."""
+    if len(intervals) < int(minimum):
+        raise AssertionError('only %d LED intervals: %s' % (len(intervals), intervals))
+    for i in intervals:
+        should_be_within(i, expected_ms, tolerance_ms)
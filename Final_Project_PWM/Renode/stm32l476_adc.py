@@ -0,0 +1,66 @@
+#
+# stm32l476_adc.py
+#
+#  Created on: Oct 19, 2026
+#      Author: Elias Asami, Milton Salazar
+#
+# Renode Python peripheral: ADC1 of the STM32L476 as driven by Src/ADC.c.
+#
+#   CR    ADCAL completes at once, ADEN sets ADRDY, ADSTART with EXTEN = 00 converts at once
+#   ISR   ADRDY / EOC / EOS, write 1 to clear
+#   DR    last conversion; reading it clears EOC
+# Everything else (CFGR, SMPR, SQR, common CCR ...) is plain storage.
+#
+# Test-only registers, at offsets the L476 leaves unused:
+#   0x0F0  INPUT_MV  voltage on the sampled channel in mV (0..3300)
+#   0x0F4  TRIGGER   write 1: a hardware-triggered conversion completes (TIM2 TRGO
+#                    stand-in); the test then raises the ADC1_2 interrupt (IRQ 18)
+
+ISR, CR, CFGR, DR = 0x00, 0x08, 0x0C, 0x40
+INPUT_MV, TRIGGER = 0xF0, 0xF4
+
+ISR_ADRDY, ISR_EOC, ISR_EOS = 1 << 0, 1 << 2, 1 << 3
+CR_ADEN, CR_ADDIS, CR_ADSTART, CR_ADSTP, CR_ADCAL = 1 << 0, 1 << 1, 1 << 2, 1 << 4, 1 << 31
+CFGR_RES_POS, CFGR_EXTEN_MASK = 3, 3 << 10
+
+VDDA_MV = 3300
+
+
+def convert():
+    bits = (12, 10, 8, 6)[(regs.get(CFGR, 0) >> CFGR_RES_POS) & 3]
+    full = (1 << bits) - 1
+    mv = min(max(regs.get(INPUT_MV, 0), 0), VDDA_MV)
+    regs[DR] = (mv * full + VDDA_MV // 2) // VDDA_MV
+    regs[ISR] = regs.get(ISR, 0) | ISR_EOC | ISR_EOS
+
+
+if request.isInit:
+    regs = {CR: 1 << 29}                        # DEEPPWD set at reset
+
+elif request.isRead:
+    request.value = regs.get(request.offset, 0)
+    if request.offset == DR:
+        regs[ISR] = regs.get(ISR, 0) & ~ISR_EOC
+
+elif request.isWrite:
+    offset, value = request.offset, request.value
+    if offset == ISR:
+        regs[ISR] = regs.get(ISR, 0) & ~value
+    elif offset == CR:
+        value &= ~CR_ADCAL                      # calibration done
+        if value & CR_ADEN:
+            regs[ISR] = regs.get(ISR, 0) | ISR_ADRDY
+        if value & CR_ADDIS:
+            regs[ISR] = regs.get(ISR, 0) & ~ISR_ADRDY
+            value &= ~(CR_ADEN | CR_ADDIS)
+        if value & CR_ADSTP:
+            value &= ~(CR_ADSTART | CR_ADSTP)
+        if value & CR_ADSTART and not regs.get(CFGR, 0) & CFGR_EXTEN_MASK:
+            convert()
+            value &= ~CR_ADSTART
+        regs[CR] = value
+    elif offset == TRIGGER:
+        if value & 1 and regs.get(CR, 0) & CR_ADSTART:
+            convert()
+    else:
+        regs[offset] = value
@@ -5,10 +5,17 @@
  *      Author: Elias Asami, Milton Salazar
  */
 #include "ADC.h"
+#include "board_config.h"
+#include "mem_sections.h"
+#include "irq_config.h"
+#include "profile.h"
+#include "latency.h"
+#include "trace.h"
 #include "stm32l476xx.h"
 #include <stdint.h>
 
 volatile uint32_t adc_result = 0; // Definition of global variable 'adc_result' declared in "ADC.h"
+adc_samples_t     adc_samples;          // Filled by ADC1_2_IRQHandler, drained by Control_Task
 
 //-------------------------------------------------------------------------------------------
 //  ADC1_Wakeup
@@ -26,7 +33,7 @@ void ADC1_Wakeup (void) {
 
 	// 3. Wait for ADC voltage regulator start-up time (T_ADCVREG_STUP)
 	//    T_ADCVREG_STUP ≈ 20 µs at 4 MHz
-	wait_time = 20 * (4000000 / 1000000);
+	wait_time = 20 * BOARD_CYCLES_PER_US;
 	while(wait_time != 0) {
 		wait_time--;
 	}
@@ -50,22 +57,6 @@ void ADC_Common_Configuration() {
 	ADC123_COMMON->CCR &= ~ADC_CCR_PRESC;
 }
 
-//-------------------------------------------------------------------------------------------
-//  ADC_Pin_Init
-//  Initialize PC0 as analog input for ADC1 channel 1 (ADC123_IN1).
-//-------------------------------------------------------------------------------------------
-void ADC_Pin_Init(void){
-
-	// 1. Enable the clock of GPIO Port C
-	RCC->AHB2ENR |= RCC_AHB2ENR_GPIOCEN;
-
-	// 2. Configure PC0 in analog mode: MODER0[1:0] = 11
-	GPIOC->MODER |= 0b11UL << (2 * 0);
-
-	// 3. Connect analog switch to the ADC input pin by configuring GPIOC_ASCR
-	GPIOC->ASCR |= 1UL << 0;
-}
-
 //--------------------------------------------------------------------------------------------------
 //  ADC_Init
 //  Initialize ADC1 in single-conversion, polling mode.
@@ -88,7 +79,7 @@ void ADC_Init(void){
 	ADC1_Wakeup();
 
 	// 5. Configure single-ended mode for channel 1 (PC0)
-	ADC1->DIFSEL &= ~ADC_DIFSEL_DIFSEL_1; 	// 0: single-ended on channel 1
+	ADC1->DIFSEL &= ~(1UL << ADC_THROTTLE_CHANNEL); 	// 0: single-ended on channel 1
 
 	// 6. Start ADC1 calibration to remove offset error
 	ADC1->CR |=  ADC_CR_ADCAL;                     // Start calibration
@@ -97,30 +88,27 @@ void ADC_Init(void){
 	// 7. Enable ADC1 module
 	ADC1->CR |= ADC_CR_ADEN;
 
-	// 8. Initialize ADC input pin PC0 as analog
-	ADC_Pin_Init();
-
-	// 9. Configure ADC data resolution and alignment
+	// 8. Configure ADC data resolution and alignment
 	//    RES[1:0] = 01 → 10-bit; ALIGN = 0 → right alignment
 	ADC1->CFGR &= ~ADC_CFGR_RES;        // Clear resolution bits
-	ADC1->CFGR |=  ADC_CFGR_RES_0;      // 10-bit resolution
+	ADC1->CFGR |=  (ADC_CFGR_RES_VALUE << ADC_CFGR_RES_Pos);  // 10-bit resolution
 	ADC1->CFGR &= ~ADC_CFGR_ALIGN;      // Right alignment
 
-	// 10. Set up the ADC regular sequence length and channel
+	// 9. Set up the ADC regular sequence length and channel
 	ADC1->SQR1 &= ~ADC_SQR1_L;          // Sequence length = 1 conversion
 	ADC1->SQR1 &= ~ADC_SQR1_SQ1;        // Clear first conversion channel
-	ADC1->SQR1 |=  (1U << 6);           // Channel 1 as the 1st conversion
+	ADC1->SQR1 |=  (ADC_THROTTLE_CHANNEL << ADC_SQR1_SQ1_Pos); // Channel 1 as the 1st conversion
 
-	// 11. Select single-conversion mode (CONT = 0)
+	// 10. Select single-conversion mode (CONT = 0)
 	ADC1->CFGR &= ~ADC_CFGR_CONT;
 
-	// 12. Disable hardware triggers; use software trigger only (EXTEN = 00)
+	// 11. Disable hardware triggers; use software trigger only (EXTEN = 00)
 	ADC1->CFGR &= ~ADC_CFGR_EXTEN;
 
-	// 13. Disable ADC interrupts (use polling for EOC)
+	// 12. Disable ADC interrupts (use polling for EOC)
 	ADC1->IER &= ~ADC_IER_EOC;          // No EOC interrupt
 
-	// 14. Wait until ADC1 is ready to accept conversions (ADRDY = 1)
+	// 13. Wait until ADC1 is ready to accept conversions (ADRDY = 1)
 	while((ADC1->ISR & ADC_ISR_ADRDY) == 0);
 }
 
@@ -133,6 +121,8 @@ void ADC_Init(void){
 //-------------------------------------------------------------------------------------------
 uint16_t ADC_Read10bit(void) {
 
+	PROFILE_BEGIN(PROF_ADC_READ);
+
 	// 1. Start a single ADC conversion by setting ADSTART
 	ADC1->CR |= ADC_CR_ADSTART;
 
@@ -145,6 +135,54 @@ uint16_t ADC_Read10bit(void) {
 	// 4. Read the conversion result from ADC1_DR
 	adc_result = ADC1->DR;   // Store in global variable for monitoring/debug
 
+	PROFILE_END(PROF_ADC_READ);
+
 	// 5. Return the 10-bit result
 	return (uint16_t)adc_result;  // 0..1023
 }
+
+//-------------------------------------------------------------------------------------------
+//  ADC_StartTriggered
+//  Switch ADC1 from software-triggered polling to hardware-triggered, interrupt-driven
+//  conversions. Each TIM2 update event (start of a 20 ms PWM frame) starts one conversion
+//  on channel 1 through TIM2_TRGO, and the EOC interrupt hands the sample to the control
+//  task. The CPU no longer has to poll, so the main loop is free to sleep.
+//-------------------------------------------------------------------------------------------
+void ADC_StartTriggered(void) {
+
+	// 1. Select TIM2_TRGO as the regular trigger source: EXTSEL[3:0] = 1011 (EXT11)
+	ADC1->CFGR &= ~ADC_CFGR_EXTSEL;
+	ADC1->CFGR |=  (11U << ADC_CFGR_EXTSEL_Pos);
+
+	// 2. Trigger on the rising edge of TRGO: EXTEN[1:0] = 01
+	ADC1->CFGR &= ~ADC_CFGR_EXTEN;
+	ADC1->CFGR |=  ADC_CFGR_EXTEN_0;
+
+	// 3. Clear any stale EOC flag and enable the EOC interrupt
+	ADC1->ISR   =  ADC_ISR_EOC;
+	ADC1->IER  |=  ADC_IER_EOCIE;
+	NVIC_EnableIRQ(ADC1_2_IRQn);
+
+	// 4. Arm the regular group; conversions now start on every trigger edge
+	ADC1->CR |= ADC_CR_ADSTART;
+}
+
+//-------------------------------------------------------------------------------------------
+//  ADC1_2_IRQHandler
+//  End of conversion for the TIM2-triggered sample: store it for Control_Task.
+//-------------------------------------------------------------------------------------------
+RAMFUNC void ADC1_2_IRQHandler(void) {
+
+	Irq_Entry(IRQ_SLOT_ADC);
+	PROFILE_BEGIN(PROF_ISR_ADC);
+
+	if (ADC1->ISR & ADC_ISR_EOC) {
+		// Reading DR also clears EOC
+		adc_result = ADC1->DR;
+		Latency_Sample();
+		adc_samples_push(&adc_samples, (uint16_t)adc_result);
+		Trace_Record(TRACE_ID_ADC_SAMPLE, (uint16_t)adc_result);
+	}
+
+	PROFILE_END(PROF_ISR_ADC);
+}
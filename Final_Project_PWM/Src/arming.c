@@ -0,0 +1,192 @@
+/*
+ * arming.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+#include "arming.h"
+#include "control.h"
+#include "LED.h"
+#include "PWM.h"
+#include "timer_wheel.h"
+#include "mem_sections.h"
+#include "param_store.h"
+#include "trace.h"
+#include <stddef.h>
+#include <stdint.h>
+
+volatile uint32_t arming_state_word = ARMING_STATE_DISARMED;
+arming_events_t   arming_events;
+
+static volatile uint8_t arming_stop_latched;   // an event was dropped (queue full)
+
+static soft_timer_t arming_timer;       // one-shot: ARMING -> ARMED
+static soft_timer_t arming_blink_timer; // periodic: fast blink while arming
+
+typedef void (*arming_action_t)(void);
+
+static void dispatch(uint8_t event);
+
+//-------------------------------------------------------------------------------------------
+//  Timer callbacks (main loop, from the timer wheel)
+//-------------------------------------------------------------------------------------------
+static void arming_blink_expired(soft_timer_t *timer) {
+
+    toggle_LED();    // LED on PA5
+}
+
+static void arming_expired(soft_timer_t *timer) {
+
+    dispatch(ARMING_EV_TIMEOUT);
+}
+
+//-------------------------------------------------------------------------------------------
+//  Entry / exit actions
+//-------------------------------------------------------------------------------------------
+static void enter_disarmed(void) {
+
+    PWM_SetPulse_us(Param_Get(PARAM_PULSE_MIN_US));     // Hold ESC at stopped pulse
+    turn_off_LED();                         // Heartbeat_Task keeps it off while inactive
+}
+
+static void enter_arming(void) {
+
+    // Start from LED off; fast blink during arming, ARMED after the arming time (3 s)
+    turn_off_LED();
+    TimerWheel_Start(&arming_timer, Param_Get(PARAM_ARMING_TIME_MS), 0, arming_expired);
+    TimerWheel_Start(&arming_blink_timer, ARMING_BLINK_MS, ARMING_BLINK_MS,
+                     arming_blink_expired);
+}
+
+static void exit_arming(void) {
+
+    TimerWheel_Stop(&arming_timer);
+    TimerWheel_Stop(&arming_blink_timer);
+}
+
+static void enter_armed(void) {
+
+    turn_on_LED();  // Start ARMED from LED ON
+}
+
+//-------------------------------------------------------------------------------------------
+//  Tables
+//  transition[state][event] -> next state; staying in the same state runs no action.
+//-------------------------------------------------------------------------------------------
+static const uint8_t transition[ARMING_STATE_COUNT][ARMING_EV_COUNT] = {
+    //               EV_BUTTON                 EV_TIMEOUT               EV_STOP
+    /* DISARMED */ { ARMING_STATE_ARMING,      ARMING_STATE_DISARMED,   ARMING_STATE_DISARMED },
+    /* ARMING   */ { ARMING_STATE_ARMING,      ARMING_STATE_ARMED,      ARMING_STATE_DISARMED },
+    /* ARMED    */ { ARMING_STATE_DISARMED,    ARMING_STATE_ARMED,      ARMING_STATE_DISARMED },
+};
+
+static const arming_action_t on_entry[ARMING_STATE_COUNT] = {
+    enter_disarmed,     // DISARMED
+    enter_arming,       // ARMING
+    enter_armed,        // ARMED
+};
+
+static const arming_action_t on_exit[ARMING_STATE_COUNT] = {
+    NULL,               // DISARMED
+    exit_arming,        // ARMING
+    NULL,               // ARMED
+};
+
+//-------------------------------------------------------------------------------------------
+//  dispatch
+//  One table lookup, at most one exit and one entry action, one store of the state word.
+//  Only called from the main loop, which makes it the single writer of the state word.
+//-------------------------------------------------------------------------------------------
+static void dispatch(uint8_t event) {
+
+    uint32_t word  = arming_state_word;
+    uint8_t  state = ARMING_WORD_STATE(word);
+    uint8_t  next;
+
+    if (event >= ARMING_EV_COUNT) {
+        return;
+    }
+
+    next = transition[state][event];
+    if (next == state) {
+        return;
+    }
+
+    if (on_exit[state] != NULL) {
+        on_exit[state]();
+    }
+
+    arming_state_word = ((ARMING_WORD_COUNT(word) + 1U) << 8) | next;
+    Trace_Record(TRACE_ID_ARM_STATE, next);
+
+    if (on_entry[next] != NULL) {
+        on_entry[next]();
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  Arming_Init
+//-------------------------------------------------------------------------------------------
+void Arming_Init(uint8_t initial_state) {
+
+    arming_state_word = initial_state;
+    on_entry[initial_state]();
+}
+
+//-------------------------------------------------------------------------------------------
+//  Arming_Post
+//  Interrupt context. The event is processed by Arming_Task within 1 ms; the stop pulse
+//  is written right away so the emergency stop does not wait for the main loop.
+//  A full queue cannot tell which of the queued presses wins, so a dropped event latches
+//  a stop: the safe outcome whatever the presses meant.
+//-------------------------------------------------------------------------------------------
+RAMFUNC void Arming_Post(uint8_t event) {
+
+    if (!arming_events_push(&arming_events, event)) {
+        arming_stop_latched = 1;
+    }
+
+    if ((event == ARMING_EV_BUTTON || arming_stop_latched) &&
+        ARMING_WORD_STATE(arming_state_word) == ARMING_STATE_ARMED) {
+        // Immediately force PWM to STOP pulse (e.g., 1 ms pulse)
+        PWM_SetPulse_us(Param_Get(PARAM_PULSE_MIN_US));
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  Arming_Task
+//-------------------------------------------------------------------------------------------
+void Arming_Task(void) {
+
+    uint8_t event;
+
+    while (arming_events_pop(&arming_events, &event)) {
+        dispatch(event);
+    }
+
+    // Dropped event: disarm after the queued ones, whatever they did
+    if (arming_stop_latched) {
+        arming_stop_latched = 0;
+        dispatch(ARMING_EV_STOP);
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  Arming_GetState
+//-------------------------------------------------------------------------------------------
+RAMFUNC uint8_t Arming_GetState(void) {
+
+    return ARMING_WORD_STATE(arming_state_word);
+}
+
+//-------------------------------------------------------------------------------------------
+//  Arming_ThrottleEnabled
+//  A queued event may be a button press that will disarm, and a latched stop will; in
+//  both cases Arming_Post has already written the stop pulse, so the throttle must not
+//  overwrite it in the meantime.
+//-------------------------------------------------------------------------------------------
+RAMFUNC uint8_t Arming_ThrottleEnabled(void) {
+
+    return ARMING_WORD_STATE(arming_state_word) == ARMING_STATE_ARMED &&
+           arming_events_count(&arming_events) == 0 && !arming_stop_latched;
+}
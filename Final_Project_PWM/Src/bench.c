@@ -0,0 +1,189 @@
+/*
+ * bench.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ *
+ *  Microbenchmarks of the control-path kernels. The kernel table is shared: Bench_Run()
+ *  times it on the target with DWT->CYCCNT, Host/bench_host.c times it on the host
+ *  against the simulated board. Both report Google Benchmark JSON, which
+ *  Tools/bench_report.py stores per commit and compares with the previous run.
+ */
+#include "bench.h"
+#include "control.h"
+#include "PWM.h"
+#include "ADC.h"
+#include "arming.h"
+#include "stm32l476xx.h"
+#include <stdio.h>
+#include <stdint.h>
+
+bench_result_t bench_results[BENCH_COUNT];
+char           bench_json[BENCH_JSON_SIZE];
+uint32_t       bench_json_len;
+
+static volatile uint32_t bench_sink;    // keeps the results of pure kernels alive
+static adc_samples_t     bench_samples; // private ring: the live one belongs to the ADC ISR
+
+//-------------------------------------------------------------------------------------------
+//  Kernels
+//-------------------------------------------------------------------------------------------
+static void bench_loop(uint32_t iterations) {
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        bench_sink += i;
+    }
+}
+
+static void bench_throttle_map(uint32_t iterations) {
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        bench_sink += Control_ThrottleToPulse_us((uint16_t)(i & 1023U));
+    }
+}
+
+static void bench_pwm_set(uint32_t iterations) {
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        PWM_SetPulse_us((uint16_t)(CONTROL_PULSE_MIN_US + (i & 1023U)));
+    }
+}
+
+static void bench_control_step(uint32_t iterations) {
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        Control_Step((uint16_t)(i & 1023U));
+    }
+}
+
+static void bench_sample_queue(uint32_t iterations) {
+
+    uint16_t sample = 0;
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        adc_samples_push(&bench_samples, (uint16_t)i);
+        adc_samples_pop(&bench_samples, &sample);
+        bench_sink += sample;
+    }
+}
+
+// Three transitions per iteration, with their entry/exit actions (LED, stop pulse,
+// timer wheel); starts and ends in ARMED
+static void bench_arming_cycle(uint32_t iterations) {
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        Arming_Post(ARMING_EV_BUTTON);      // ARMED -> DISARMED (forces the stop pulse)
+        Arming_Task();
+        Arming_Post(ARMING_EV_BUTTON);      // -> ARMING (starts both arming timers)
+        Arming_Task();
+        Arming_Post(ARMING_EV_TIMEOUT);     // -> ARMED (stops them)
+        Arming_Task();
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  Kernel table (order of the BENCH_* IDs)
+//-------------------------------------------------------------------------------------------
+const bench_t bench_table[BENCH_COUNT] = {
+    { "throttle_map",  bench_throttle_map  },
+    { "pwm_set",       bench_pwm_set       },
+    { "control_step",  bench_control_step  },
+    { "sample_queue",  bench_sample_queue  },
+    { "arming_cycle",  bench_arming_cycle  },
+};
+
+const uint32_t bench_count = BENCH_COUNT;
+
+//-------------------------------------------------------------------------------------------
+//  bench_time
+//  Fastest of BENCH_REPEAT batches, interrupts masked, after one warm-up batch (flash
+//  prefetch and ART cache).
+//-------------------------------------------------------------------------------------------
+static uint32_t bench_time(void (*run)(uint32_t)) {
+
+    uint32_t best = UINT32_MAX;
+
+    run(BENCH_ITERATIONS);
+
+    for (uint32_t r = 0; r < BENCH_REPEAT; r++) {
+        __disable_irq();
+        uint32_t start  = DWT->CYCCNT;
+        run(BENCH_ITERATIONS);
+        uint32_t cycles = DWT->CYCCNT - start;
+        __enable_irq();
+
+        if (cycles < best) {
+            best = cycles;
+        }
+    }
+    return best;
+}
+
+//-------------------------------------------------------------------------------------------
+//  bench_write_json
+//  Google Benchmark layout; times with two decimals (integer formatting only).
+//-------------------------------------------------------------------------------------------
+static void bench_write_json(void) {
+
+    const uint32_t NS_PER_CYCLE = 1000000000U / BENCH_CLOCK_HZ;
+    uint32_t       len = 0;
+
+    len += (uint32_t)snprintf(&bench_json[len], BENCH_JSON_SIZE - len,
+                              "{\"context\":{\"host_name\":\"stm32l476rg\",\"num_cpus\":1,"
+                              "\"mhz_per_cpu\":%lu,\"library_build_type\":\"release\"},"
+                              "\"benchmarks\":[",
+                              (unsigned long)(BENCH_CLOCK_HZ / 1000000U));
+
+    for (uint32_t i = 0; i < BENCH_COUNT && len < BENCH_JSON_SIZE; i++) {
+        uint32_t cyc = bench_results[i].cycles_per_op_x100;
+        uint32_t ns  = cyc * NS_PER_CYCLE;
+
+        len += (uint32_t)snprintf(&bench_json[len], BENCH_JSON_SIZE - len,
+                                  "%s{\"name\":\"%s\",\"run_name\":\"%s\",\"run_type\":\"iteration\","
+                                  "\"repetitions\":%lu,\"iterations\":%lu,"
+                                  "\"real_time\":%lu.%02lu,\"cpu_time\":%lu.%02lu,\"time_unit\":\"ns\","
+                                  "\"cycles_per_op\":%lu.%02lu}",
+                                  (i != 0U) ? "," : "", bench_table[i].name, bench_table[i].name,
+                                  (unsigned long)BENCH_REPEAT,
+                                  (unsigned long)bench_results[i].iterations,
+                                  (unsigned long)(ns / 100U), (unsigned long)(ns % 100U),
+                                  (unsigned long)(ns / 100U), (unsigned long)(ns % 100U),
+                                  (unsigned long)(cyc / 100U), (unsigned long)(cyc % 100U));
+    }
+    if (len < BENCH_JSON_SIZE) {
+        len += (uint32_t)snprintf(&bench_json[len], BENCH_JSON_SIZE - len, "]}\n");
+    }
+    bench_json_len = (len < BENCH_JSON_SIZE) ? len : BENCH_JSON_SIZE - 1U;
+}
+
+//-------------------------------------------------------------------------------------------
+//  Bench_Run
+//-------------------------------------------------------------------------------------------
+void Bench_Run(void) {
+
+    // 1. Cycle counter
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+    // 2. What the kernels touch, without starting anything: TIM2 clocked so the CCR1
+    //    writes take their real time, but with its counter and CH1 output still off
+    //    (PWM_Init() configures it later); arming cycles start and end in ARMED
+    RCC->APB1ENR1 |= RCC_APB1ENR1_TIM2EN;
+    Arming_Init(ARMING_STATE_ARMED);
+
+    // 3. Loop overhead, removed from every kernel
+    uint32_t overhead = bench_time(bench_loop);
+
+    // 4. Kernels
+    for (uint32_t i = 0; i < BENCH_COUNT; i++) {
+        uint32_t cycles = bench_time(bench_table[i].run);
+
+        cycles = (cycles > overhead) ? cycles - overhead : 0U;
+        bench_results[i].iterations         = BENCH_ITERATIONS;
+        bench_results[i].cycles             = cycles;
+        bench_results[i].cycles_per_op_x100 = (uint32_t)((uint64_t)cycles * 100U / BENCH_ITERATIONS);
+    }
+
+    // 5. Machine-readable copy
+    bench_write_json();
+}
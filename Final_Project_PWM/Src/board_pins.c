@@ -0,0 +1,55 @@
+/*
+ * board_pins.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+#include "board_pins.h"
+#include "gpio.h"
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+// Clock enable bits of the ports in the table
+#define BOARD_PORT_CLOCKS                                                                   \
+    ((BOARD_PORT_PINS(GPIO_PORT_A) ? RCC_AHB2ENR_GPIOAEN : 0UL) |                           \
+     (BOARD_PORT_PINS(GPIO_PORT_B) ? RCC_AHB2ENR_GPIOBEN : 0UL) |                           \
+     (BOARD_PORT_PINS(GPIO_PORT_C) ? RCC_AHB2ENR_GPIOCEN : 0UL) |                           \
+     (BOARD_PORT_PINS(GPIO_PORT_D) ? RCC_AHB2ENR_GPIODEN : 0UL) |                           \
+     (BOARD_PORT_PINS(GPIO_PORT_H) ? RCC_AHB2ENR_GPIOHEN : 0UL))
+
+// One read-modify-write of a register, only the fields of the listed pins change
+#define BOARD_WRITE(reg, mask, value)   ((reg) = ((reg) & ~(uint32_t)(mask)) | (uint32_t)(value))
+
+//-------------------------------------------------------------------------------------------
+//  Board_Port_Init
+//  All pins of port P. Alternate function before mode, so a pin switched to AF never
+//  drives the previous function; ports without pins compile to nothing.
+//-------------------------------------------------------------------------------------------
+#define Board_Port_Init(P)                                                                  \
+    do {                                                                                    \
+        if (BOARD_PORT_PINS(P) != 0UL) {                                                    \
+            GPIO_TypeDef *port = Gpio_Port(P);                                              \
+            if (BOARD_PORT_MASK_AFRL(P)) BOARD_WRITE(port->AFR[0], BOARD_PORT_MASK_AFRL(P), BOARD_PORT_AFRL(P)); \
+            if (BOARD_PORT_MASK_AFRH(P)) BOARD_WRITE(port->AFR[1], BOARD_PORT_MASK_AFRH(P), BOARD_PORT_AFRH(P)); \
+            BOARD_WRITE(port->OTYPER, BOARD_PORT_PINS(P),  BOARD_PORT_OTYPER(P));          \
+            BOARD_WRITE(port->PUPDR,  BOARD_PORT_MASK2(P), BOARD_PORT_PUPDR(P));           \
+            BOARD_WRITE(port->MODER,  BOARD_PORT_MASK2(P), BOARD_PORT_MODER(P));           \
+            if (BOARD_PORT_ASCR(P)) port->ASCR |= BOARD_PORT_ASCR(P);                      \
+        }                                                                                   \
+    } while (0)
+
+//-------------------------------------------------------------------------------------------
+//  Board_Pins_Init
+//-------------------------------------------------------------------------------------------
+void Board_Pins_Init(void) {
+
+    // 1. Enable the clocks of all used ports in one write
+    RCC->AHB2ENR |= BOARD_PORT_CLOCKS;
+
+    // 2. Configure each port: every register written once, with compile-time values
+    Board_Port_Init(GPIO_PORT_A);
+    Board_Port_Init(GPIO_PORT_B);
+    Board_Port_Init(GPIO_PORT_C);
+    Board_Port_Init(GPIO_PORT_D);
+    Board_Port_Init(GPIO_PORT_H);
+}
@@ -5,68 +5,181 @@
  *      Author: Elias Asami, Milton Salazar
  */
 #include "button.h"
-#include "LED.h"
-#include "PWM.h"
-#include "Systick_timer.h"
+#include "arming.h"
+#include "board_config.h"
+#include "board_pins.h"
+#include "gpio.h"
+#include "mem_sections.h"
+#include "timebase.h"
+#include "irq_config.h"
+#include "profile.h"
+#include "trace.h"
 #include "stm32l476xx.h"
 #include <stdint.h>
 
-// Flags are defined in main.c
-extern volatile uint8_t  system_active;
-extern volatile uint8_t  system_arming;
-extern volatile uint32_t arming_ms;
+// PC13  <--> Blue User Button (active low), PIN_BUTTON: input with pull-up (the Nucleo
+// also has an external one), released = high
 
-// PC13  <--> Blue User Button
-#define BUTTON_PIN   13
-#define PWM_STOP_TICKS  1000
+button_events_t button_events;
 
-void button_Init(void) {
-    // 1. Enable the clock to GPIO Port C
-    RCC->AHB2ENR |= RCC_AHB2ENR_GPIOCEN;
+static volatile uint8_t btn_pressed = 0;       // debounced level, 1 = held down
+static uint32_t         press_us    = 0;       // start of the current press
+static uint32_t         release_us  = 0;       // end of the last SHORT press
+static uint8_t          last_short  = 0;       // last gesture was SHORT (double-press candidate)
+
+static inline uint8_t pin_pressed(void) {
+    return Gpio_Read(PIN_BUTTON) == 0;
+}
+
+static inline void push_event(uint8_t type, uint32_t time_us) {
+    button_event_t ev = { time_us, type };
+    button_events_push(&button_events, ev);
+}
+
+//-------------------------------------------------------------------------------------------
+//  Debounce timer (TIM6, one-shot)
+//  TIM6 clock = 4 MHz, PSC = 3999 -> 1 kHz, ARR = BUTTON_DEBOUNCE_MS - 1.
+//-------------------------------------------------------------------------------------------
+static void debounce_Timer_Init(void) {
+
+    // 1. Enable clock for TIM6 on APB1 bus
+    RCC->APB1ENR1 |= RCC_APB1ENR1_TIM6EN;
+
+    // 2. 1 ms per count, one-pulse mode (CEN clears itself at the update event)
+    TIM6->PSC  = BOARD_MS_TIMER_PSC;
+    TIM6->ARR  = BUTTON_DEBOUNCE_MS - 1;
+    TIM6->CR1  = TIM_CR1_OPM | TIM_CR1_URS;   // Only overflow sets UIF, not UG
+    TIM6->EGR  = TIM_EGR_UG;                  // Load PSC
+    TIM6->SR   = 0;
+
+    // 3. Enable update interrupt
+    TIM6->DIER |= TIM_DIER_UIE;
+    NVIC_EnableIRQ(TIM6_DAC_IRQn);
+}
+
+static inline void debounce_Start(void) {
+    TIM6->CNT  = 0;
+    TIM6->CR1 |= TIM_CR1_CEN;
+}
+
+//-------------------------------------------------------------------------------------------
+//  button_Edge
+//  Act on an edge at once (leading-edge debounce: no added stop latency), then ignore
+//  the contact until the debounce timer has re-sampled the pin.
+//-------------------------------------------------------------------------------------------
+static void button_Edge(void) {
 
-    // 2. Configure PC13 as input
-    GPIOC->MODER &= ~(3UL << (2 * BUTTON_PIN));    // Input(00)
+    uint32_t now = (uint32_t)now_us();
 
-    // 3. No pull-up or pull-down
-    GPIOC->PUPDR &= ~(3UL << (2 * BUTTON_PIN));
+    if (!btn_pressed) {
+        // Press: ARMED → DISARMED (stop pulse written immediately), DISARMED → ARMING
+        btn_pressed = 1;
+        press_us    = now;
+        push_event(BUTTON_EVENT_PRESS, now);
+        Trace_Record(TRACE_ID_BUTTON_EDGE, 1);
+        Arming_Post(ARMING_EV_BUTTON);
+    }
+    else {
+        // Release: classify the gesture by press duration and gap to the last press
+        uint32_t held = now - press_us;
+        btn_pressed   = 0;
+        Trace_Record(TRACE_ID_BUTTON_EDGE, 0);
 
-    // 4. Configure EXTI line 13 to be triggered by PC13
+        if (held >= BUTTON_LONG_MS * 1000U) {
+            push_event(BUTTON_EVENT_LONG, now);
+            last_short = 0;
+        }
+        else if (last_short && (press_us - release_us) < BUTTON_DOUBLE_MS * 1000U) {
+            push_event(BUTTON_EVENT_DOUBLE, now);
+            last_short = 0;
+        }
+        else {
+            push_event(BUTTON_EVENT_SHORT, now);
+            last_short = 1;
+            release_us = now;
+        }
+    }
+
+    debounce_Start();
+}
+
+uint8_t button_Busy(void) {
+    return (TIM6->CR1 & TIM_CR1_CEN) != 0;
+}
+
+void button_Init(void) {
+    // 1. PC13 is an input with pull-up (Board_Pins_Init). Configure EXTI line 13 to be triggered by PC13
     RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;              // Enable SYSCFG clock
     SYSCFG->EXTICR[3] &= ~(SYSCFG_EXTICR4_EXTI13);
     SYSCFG->EXTICR[3] |=  SYSCFG_EXTICR4_EXTI13_PC;    // EXTI13 <- PC13
 
-    // 5. Enable falling-edge trigger on line 13
-    EXTI->IMR1  |=  EXTI_IMR1_IM13;     // Unmask
+    // 2. Debounce timer
+    debounce_Timer_Init();
+
+    // 3. Enable falling-edge trigger on line 13 (press); switched to rising while held
+    EXTI->RTSR1 &= ~EXTI_RTSR1_RT13;
     EXTI->FTSR1 |=  EXTI_FTSR1_FT13;    // Falling edge
     EXTI->PR1    =  EXTI_PR1_PIF13;     // Clear any pending flag
+    EXTI->IMR1  |=  EXTI_IMR1_IM13;     // Unmask
 
-    // 6. Enable EXTI15_10 interrupt in NVIC
+    // 4. Enable EXTI15_10 interrupt in NVIC
     NVIC_EnableIRQ(EXTI15_10_IRQn);
 }
 
-void EXTI15_10_IRQHandler(void) {
+//-------------------------------------------------------------------------------------------
+//  EXTI15_10_IRQHandler
+//  First edge of a press or release: mask the line so contact bounce cannot interrupt
+//  again, handle the edge and start the debounce timer.
+//-------------------------------------------------------------------------------------------
+RAMFUNC void EXTI15_10_IRQHandler(void) {
+    Irq_Entry(IRQ_SLOT_BUTTON);
+    PROFILE_BEGIN(PROF_ISR_BUTTON);
+
     // Check if EXTI13 triggered
     if (EXTI->PR1 & EXTI_PR1_PIF13) {
-        EXTI->PR1 = EXTI_PR1_PIF13;   // Clear pending flag
-
-        if (system_active) {
-            // ARMED → DISARMED
-            system_active = 0;
-            system_arming = 0;
-            arming_ms     = 0;
-
-            // Immediately force PWM to STOP pulse (e.g., 1 ms pulse)
-            PWM_SetPulse_us(PWM_STOP_TICKS);
-            // Stop LED (SysTick_Handler will keep it off while inactive)
-            turn_off_LED();
-        }
-        else if (!system_arming) {
-            // DISARMED → start ARMING sequence
-            system_arming = 1;
-            arming_ms     = 0;
+        EXTI->IMR1 &= ~EXTI_IMR1_IM13;  // Mask until the contact has settled
+        EXTI->PR1   =  EXTI_PR1_PIF13;  // Clear pending flag
 
-            // Start from LED off; SysTick will fast blink during arming
-            turn_off_LED();
-        }
+        button_Edge();
+    }
+
+    PROFILE_END(PROF_ISR_BUTTON);
+}
+
+//-------------------------------------------------------------------------------------------
+//  TIM6_DACUNDER_IRQHandler
+//  Debounce period over: re-sample PC13.
+//    - Level changed during the lockout (short tap): handle that edge now and lock out
+//      again.
+//    - Otherwise: arm EXTI for the opposite edge and unmask the line.
+//-------------------------------------------------------------------------------------------
+RAMFUNC void TIM6_DACUNDER_IRQHandler(void) {
+
+    Irq_Entry(IRQ_SLOT_DEBOUNCE);
+
+    if (!(TIM6->SR & TIM_SR_UIF)) {
+        return;
+    }
+    TIM6->SR = 0;
+
+    if (pin_pressed() != btn_pressed) {
+        button_Edge();
+        return;
+    }
+
+    if (btn_pressed) {
+        EXTI->FTSR1 &= ~EXTI_FTSR1_FT13;
+        EXTI->RTSR1 |=  EXTI_RTSR1_RT13;     // Wait for release
+    }
+    else {
+        EXTI->RTSR1 &= ~EXTI_RTSR1_RT13;
+        EXTI->FTSR1 |=  EXTI_FTSR1_FT13;     // Wait for press
+    }
+    EXTI->PR1   =  EXTI_PR1_PIF13;
+    EXTI->IMR1 |=  EXTI_IMR1_IM13;
+
+    // The pin may have moved between the sample and the unmask: pend the line by software
+    if (pin_pressed() != btn_pressed) {
+        EXTI->SWIER1 = EXTI_SWIER1_SWI13;
     }
 }
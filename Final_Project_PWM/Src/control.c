@@ -0,0 +1,80 @@
+/*
+ * control.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+#include "control.h"
+#include "board_config.h"
+#include "PWM.h"
+#include "arming.h"
+#include "irq_config.h"
+#include "mem_sections.h"
+#include "param_store.h"
+#include "profile.h"
+#include "latency.h"
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+// (value * span) / 1023 as (value * M) >> 20 with M = ceil(span * 2^20 / 1023): exact for
+// every ADC code and every span up to 1300 us (the endpoint ranges give at most 1200)
+#define CONTROL_THROTTLE_SHIFT  20U
+#define CONTROL_SPAN_MAX_US     1300U
+
+_Static_assert(CONFIG_RECIP_EXACT(ADC_FULL_SCALE, CONTROL_PULSE_SPAN_US, ADC_FULL_SCALE,
+                                  CONTROL_THROTTLE_SHIFT),
+               "throttle mapping is not exact over the ADC range");
+_Static_assert((uint64_t)ADC_FULL_SCALE *
+               CONFIG_RECIP_MUL(CONTROL_SPAN_MAX_US, ADC_FULL_SCALE, CONTROL_THROTTLE_SHIFT) <=
+               UINT32_MAX, "throttle mapping overflows");
+
+// Endpoints and multiplier, recomputed when a parameter changes (param_version)
+static uint32_t pulse_min_us   = CONTROL_PULSE_MIN_US;
+static uint32_t pulse_mul      = CONFIG_RECIP_MUL(CONTROL_PULSE_SPAN_US, ADC_FULL_SCALE,
+                                                  CONTROL_THROTTLE_SHIFT);
+static uint32_t pulse_version  = 0;
+
+//-------------------------------------------------------------------------------------------
+//  Control_ThrottleToPulse_us
+//  Map ADC value (0..1023) to pulse width min..max us (1000..2000 us)
+//
+//    us = min + (value / 1023) * (max - min)
+//    Integer math: us = min + (value * span) / 1023, without the division
+//-------------------------------------------------------------------------------------------
+RAMFUNC uint16_t Control_ThrottleToPulse_us(uint16_t value) {
+
+    if (pulse_version != param_version) {
+        uint32_t span = Param_Get(PARAM_PULSE_MAX_US) - Param_Get(PARAM_PULSE_MIN_US);
+        pulse_min_us  = Param_Get(PARAM_PULSE_MIN_US);
+        pulse_mul     = CONFIG_RECIP_MUL(span, ADC_FULL_SCALE, CONTROL_THROTTLE_SHIFT);
+        pulse_version = param_version;
+    }
+    return (uint16_t)(pulse_min_us + ((value * pulse_mul) >> CONTROL_THROTTLE_SHIFT));
+}
+
+//-------------------------------------------------------------------------------------------
+//  Control_Step
+//    - If ARMED: update PWM pulse width from the throttle sample.
+//    - Otherwise: hold ESC at a "stopped" pulse.
+//  TIM2 CCR1 is preloaded, so the new value takes effect at the next frame boundary.
+//  The check and the commit run with the protection level masked (BASEPRI): a button
+//  press either lands before (and is seen as a pending event) or after (and its stop
+//  pulse wins).
+//-------------------------------------------------------------------------------------------
+RAMFUNC void Control_Step(uint16_t value) {
+
+    PROFILE_BEGIN(PROF_CONTROL_STEP);
+
+    uint16_t us   = Control_ThrottleToPulse_us(value);
+    uint32_t lock = Irq_Lock(IRQ_PRIO_PROTECTION);
+
+    if (!Arming_ThrottleEnabled()) {
+        us = (uint16_t)Param_Get(PARAM_PULSE_MIN_US);	// Hold ESC at stopped pulse 1000 us
+    }
+    PWM_SetPulse_us(us);
+    Latency_Commit();
+
+    Irq_Unlock(lock);
+
+    PROFILE_END(PROF_CONTROL_STEP);
+}
@@ -0,0 +1,78 @@
+/*
+ * irq_config.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+#include "irq_config.h"
+#include "mem_sections.h"
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+irq_latency_t     irq_latency[IRQ_SLOT_COUNT];
+volatile uint32_t irq_probe_slot  = 0;
+volatile uint32_t irq_probe_stamp = 0;
+
+static uint32_t next_probe = 0;
+
+// Priority map, indexed by IRQ_SLOT_* (Tools/stack_report.py reads its levels from here)
+static const struct {
+    IRQn_Type irq;
+    uint8_t   prio;
+} irq_map[IRQ_SLOT_COUNT] = {
+    { EXTI15_10_IRQn, IRQ_PRIO_PROTECTION   },
+    { TIM6_DAC_IRQn,  IRQ_PRIO_PROTECTION   },
+    { ADC1_2_IRQn,    IRQ_PRIO_CONTROL      },
+    { TIM5_IRQn,      IRQ_PRIO_HOUSEKEEPING },
+    { SysTick_IRQn,   IRQ_PRIO_HOUSEKEEPING },
+    { TIM2_IRQn,      IRQ_PRIO_CONTROL      },
+};
+
+//-------------------------------------------------------------------------------------------
+//  Irq_Init
+//-------------------------------------------------------------------------------------------
+void Irq_Init(void) {
+
+    // 1. All 4 priority bits are preemption bits: PRIGROUP = 3 (group 4, sub 0)
+    NVIC_SetPriorityGrouping(3);
+
+    // 2. Program every source in the map
+    for (uint32_t i = 0; i < IRQ_SLOT_COUNT; i++) {
+        NVIC_SetPriority(irq_map[i].irq, irq_map[i].prio);
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  Irq_Record
+//-------------------------------------------------------------------------------------------
+RAMFUNC void Irq_Record(uint32_t slot, uint32_t cycles) {
+
+    irq_latency_t *lat = &irq_latency[slot];
+
+    lat->samples++;
+    lat->last_cycles = cycles;
+    if (cycles > lat->max_cycles) {
+        lat->max_cycles = cycles;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  Irq_LatencyProbe
+//  Handlers check their own status flags, so a software pend is harmless: the handler
+//  only records the entry time. SysTick is skipped (it would add a scheduler tick) and
+//  measured on every real tick instead. TIM2 is skipped as well: its interrupt is only
+//  enabled in the latency measurement mode.
+//-------------------------------------------------------------------------------------------
+void Irq_LatencyProbe(void) {
+
+    if (irq_probe_slot != 0) {
+        return;     // previous probe not taken yet (its handler is blocked or disabled)
+    }
+
+    uint32_t slot = next_probe;
+    next_probe = (next_probe + 1U) % IRQ_SLOT_SYSTICK;
+
+    irq_probe_stamp = TIM5->CNT;
+    irq_probe_slot  = slot + 1U;
+    NVIC_SetPendingIRQ(irq_map[slot].irq);
+}
@@ -0,0 +1,140 @@
+/*
+ * latency.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+#include "latency.h"
+#include "timebase.h"
+#include "irq_config.h"
+#include "mem_sections.h"
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+latency_frames_t          latency_frames;
+volatile latency_report_t latency_report;
+
+volatile uint32_t latency_frame_stamp    = 0;
+volatile uint32_t latency_sample_frame   = 0;
+volatile uint32_t latency_sample_stamp   = 0;
+volatile uint32_t latency_pending_frame  = 0;
+volatile uint32_t latency_pending_sample = 0;
+volatile uint32_t latency_pending_commit = 0;
+volatile uint8_t  latency_pending_valid  = 0;
+
+//-------------------------------------------------------------------------------------------
+//  Latency_Init
+//-------------------------------------------------------------------------------------------
+void Latency_Init(void) {
+
+    // 1. Start the timeline at the current frame
+    latency_frame_stamp   = TIM5->CNT;
+    latency_pending_valid = 0;
+
+    // 2. Interrupt on every TIM2 update event (frame boundary)
+    TIM2->SR    = (uint32_t)~TIM_SR_UIF;
+    TIM2->DIER |= TIM_DIER_UIE;
+    NVIC_EnableIRQ(TIM2_IRQn);
+}
+
+//-------------------------------------------------------------------------------------------
+//  TIM2_IRQHandler
+//  Frame boundary: the CCR1 value committed before this event goes out now, and a new
+//  ADC conversion has just been triggered.
+//  The event time is the entry stamp minus the TIM2 counts already elapsed, so a handler
+//  delayed by a critical section is still placed within one TIM2 count (20 us).
+//-------------------------------------------------------------------------------------------
+RAMFUNC void TIM2_IRQHandler(void) {
+
+    Irq_Entry(IRQ_SLOT_FRAME);
+
+    if (TIM2->SR & TIM_SR_UIF) {
+        TIM2->SR = (uint32_t)~TIM_SR_UIF;
+
+        uint32_t update = TIM5->CNT - TIM2->CNT * (TIM2->PSC + 1U);
+
+        // The pending commit is on the output from this edge on, unless it was written
+        // after the event (handler delayed past it)
+        if (latency_pending_valid && (int32_t)(update - latency_pending_commit) >= 0) {
+            latency_frame_t f;
+
+            f.acquire_us = (latency_pending_sample - latency_pending_frame) / TIMEBASE_CYCLES_PER_US;
+            f.compute_us = (latency_pending_commit - latency_pending_sample) / TIMEBASE_CYCLES_PER_US;
+            f.total_us   = (update - latency_pending_frame) / TIMEBASE_CYCLES_PER_US;
+            latency_frames_push(&latency_frames, f);
+
+            latency_pending_valid = 0;
+        }
+
+        latency_frame_stamp = update;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  sort_u32
+//  Insertion sort; windows are at most 64 entries.
+//-------------------------------------------------------------------------------------------
+static void sort_u32(uint32_t *v, uint32_t n) {
+
+    for (uint32_t i = 1; i < n; i++) {
+        uint32_t x = v[i];
+        uint32_t j = i;
+        while (j > 0 && v[j - 1] > x) {
+            v[j] = v[j - 1];
+            j--;
+        }
+        v[j] = x;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  distribution
+//  Nearest-rank percentiles of n (> 0) values; sorts v in place.
+//-------------------------------------------------------------------------------------------
+static latency_dist_t distribution(uint32_t *v, uint32_t n) {
+
+    latency_dist_t d;
+
+    sort_u32(v, n);
+    d.p50 = v[(n * 50U + 99U) / 100U - 1U];
+    d.p99 = v[(n * 99U + 99U) / 100U - 1U];
+    d.max = v[n - 1U];
+
+    return d;
+}
+
+//-------------------------------------------------------------------------------------------
+//  Latency_Report
+//-------------------------------------------------------------------------------------------
+void Latency_Report(void) {
+
+    static uint32_t acquire[64];
+    static uint32_t compute[64];
+    static uint32_t total[64];
+    uint32_t        frame_us = ((TIM2->ARR + 1U) * (TIM2->PSC + 1U)) / TIMEBASE_CYCLES_PER_US;
+    uint32_t        n        = 0;
+    uint32_t        late     = 0;
+    latency_frame_t f;
+
+    // 1. Drain the frames collected since the last report
+    while (n < 64U && latency_frames_pop(&latency_frames, &f)) {
+        acquire[n] = f.acquire_us;
+        compute[n] = f.compute_us;
+        total[n]   = f.total_us;
+        if (f.total_us > frame_us + frame_us / 2U) {     // applied one frame later
+            late++;
+        }
+        n++;
+    }
+
+    if (n == 0) {
+        return;
+    }
+
+    // 2. Publish the distributions
+    latency_report.frames  = n;
+    latency_report.late    = late;
+    latency_report.acquire = distribution(acquire, n);
+    latency_report.compute = distribution(compute, n);
+    latency_report.total   = distribution(total, n);
+}
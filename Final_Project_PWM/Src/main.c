@@ -6,58 +6,109 @@
  */
 
 #include "stm32l476xx.h"
+#include "board_config.h"
+#include "board_pins.h"
 #include "LED.h"
 #include "button.h"
 #include "ADC.h"
 #include "PWM.h"
 #include "Systick_timer.h"
+#include "power.h"
+#include "mem_sections.h"
+#include "param_store.h"
+#include "timebase.h"
+#include "scheduler.h"
+#include "timer_wheel.h"
+#include "arming.h"
+#include "irq_config.h"
+#include "profile.h"
+#include "latency.h"
+#include "trace.h"
+#include "stack_monitor.h"
+#include "bench.h"
 #include <stdint.h>
 
 
-volatile uint8_t  system_active = 1;   // start
-volatile uint8_t  system_arming = 0;   // 1 during arming delay
-volatile uint32_t arming_ms     = 0;   // ms counter for arming state
-
 int main(void){
 
-    // 1. Initialize status LED (PA5, LD2)
-    configure_LED_pin();
-    turn_on_LED();       // Start with system active
+    // 0. Optionally run from the SRAM2 copy of the vector table (before any IRQ is enabled)
+    if (RELOCATE_VECTOR_TABLE) {
+        VectorTable_RelocateToSRAM2();
+    }
+
+    // 1. Interrupt priority map, before any driver enables its interrupt
+    Irq_Init();
+
+    // 2. MPU guard band below the stack: an overflow faults and forces the stop pulse
+    StackMonitor_Init();
+
+    // 3. Start the 64-bit monotonic clock (TIM5) before anything that timestamps
+    Timebase_Init();
+
+    // 4. Tunable parameters (arming time, heartbeat, pulse endpoints) from flash into
+    //    their RAM shadow, before the modules that read them
+    Param_Init();
+
+    // 5. Configure every pin of the board in one pass (board_pins.h): LED (PA5, LD2),
+    //    button (PC13), throttle (PC0), PWM (PA0) and trace TX (PA2)
+    Board_Pins_Init();
+
+    // 6. Optionally time the control-path kernels (bench_results / bench_json). Runs before
+    //    the PWM output, the ADC trigger and SysTick are started, so the ESC never sees
+    //    the pulse sweep; the trace and timer wheel inits below discard what it left.
+    if (BENCH_ENABLE) {
+        Bench_Run();
+    }
 
-    // 2. Initialize the user pushbutton and EXTI interrupt
+    // 7. Event trace (stamped by TIM5); optional USART2 link
+    Trace_Init();
+
+    // 8. Initialize the user pushbutton and EXTI interrupt
     button_Init(); // PC13
 
-    // 3. Initialize SysTick
-    SysTick_Init(4000);	// 1 ms ticks (4 MHz / 4000 = 1 kHz)
+    // 9. Initialize the task scheduler, the timer wheel and SysTick (their time source)
+    Scheduler_Init();
+    TimerWheel_Init(0);
+    SysTick_Init(BOARD_TICK_RELOAD);	// 1 ms ticks (4 MHz / 4000 = 1 kHz)
 
-    // 4. Initialize ADC
+    // 10. Initialize ADC
     ADC_Init();	//(0–3.3 V)throttle input
 
-    // 5. Initialize PWM
+    // 11. Initialize PWM
     PWM_Init();	// (TIM2_CH1 on PA0) for ESC pulse output
 
-    // 6. Main control loop:
-    //    - If system_active = 1: read throttle (ADC) and update PWM pulse width.
-    //    - If system_active = 0: hold ESC at a "stopped" pulse.
-    while (1) {
+    // 12. Enter the initial arm state: start with system active (ARMED, LED on)
+    Arming_Init(ARMING_STATE_ARMED);
 
-        if (system_active) {
-            // System running:
-            // 1) Read one 10-bit ADC sample (0..1023)
-            uint16_t value = ADC_Read10bit();
+    // 13. Start TIM2-triggered ADC sampling; each EOC interrupt delivers one sample
+    ADC_StartTriggered();
 
-            // 2) Map ADC value (0..1023) to pulse width 1000..2000 us
-            //
-            //    us = 1000 us + (value / 1023) * 1000 us
-            //    Integer math: us = 1000 + (value * 1000) / 1023
-            uint16_t us = 1000 + (value * 1000) / 1023;
+    // 14. Optionally time every frame from ADC trigger to PWM edge (TIM2 update interrupt)
+    if (LATENCY_MEASURE) {
+        Latency_Init();
+    }
 
-            // 3) Update PWM output for ESC
-            PWM_SetPulse_us(us);
-        }
-        else {
-            // System paused/disarmed:
-            PWM_SetPulse_us(1000);	// Hold ESC at stopped pulse 1000 us
+    // 15. Initialize low-power idle
+    Power_Init();
+
+    // 16. Start the cycle counter probes (empty unless PROFILE_ENABLE)
+    Profile_Init();
+
+    // 17. Main loop:
+    //    Run every task released by SysTick (control, arming, heartbeat, telemetry),
+    //    then sleep until the next interrupt.
+    //    - If ARMED: Control_Task updates PWM pulse width from throttle.
+    //    - Otherwise: Control_Task holds ESC at a "stopped" pulse.
+    while (1) {
+        Scheduler_Run();
+
+        // Re-check with interrupts masked so a tick that lands between Scheduler_Run()
+        // and WFI is not slept through; WFI still wakes on the pending SysTick.
+        // PRIMASK, not BASEPRI: interrupts masked by BASEPRI do not wake WFI.
+        __disable_irq();
+        if (!Scheduler_Pending()) {
+            Power_Idle();
         }
+        __enable_irq();
     }
 }
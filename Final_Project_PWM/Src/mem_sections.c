@@ -0,0 +1,35 @@
+/*
+ * mem_sections.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+#include "mem_sections.h"
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+// Flash vector table (startup_stm32l476rgtx.s)
+extern const uint32_t g_pfnVectors[];
+
+// RAM copy, aligned by the linker script (.sram2_vectors)
+__attribute__((section(".ram_vectors"), used))
+static uint32_t ram_vectors[VECTOR_TABLE_ENTRIES];
+
+//-------------------------------------------------------------------------------------------
+//  VectorTable_RelocateToSRAM2
+//  Copy the vector table from flash to SRAM2 and switch VTOR to the copy, so exception
+//  entry fetches the handler address without flash wait states.
+//  Must be called before any interrupt is enabled.
+//-------------------------------------------------------------------------------------------
+void VectorTable_RelocateToSRAM2(void) {
+
+    // 1. Copy all entries (initial SP, exceptions, IRQs)
+    for (uint32_t i = 0; i < VECTOR_TABLE_ENTRIES; i++) {
+        ram_vectors[i] = g_pfnVectors[i];
+    }
+
+    // 2. Point VTOR at the copy and make sure the write completes before any exception
+    SCB->VTOR = (uint32_t)ram_vectors;
+    __DSB();
+    __ISB();
+}
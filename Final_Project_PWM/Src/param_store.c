@@ -0,0 +1,368 @@
+/*
+ * param_store.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+#include "param_store.h"
+#include "arming.h"
+#include "stack_monitor.h"
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+#define PARAM_DEFAULT_(name, def, min, max, step)   (def),
+#define PARAM_MIN_(name, def, min, max, step)       (min),
+#define PARAM_MAX_(name, def, min, max, step)       (max),
+#define PARAM_STEP_(name, def, min, max, step)      (step),
+#define PARAM_CHECK_(name, def, min, max, step)                                             \
+    _Static_assert((min) <= (def) && (def) <= (max) && (step) >= 1 && (def) % (step) == 0,  \
+                   #name ": default out of range");
+
+PARAM_TABLE(PARAM_CHECK_)
+
+static const uint32_t param_min[PARAM_COUNT]     = { PARAM_TABLE(PARAM_MIN_) };
+static const uint32_t param_max[PARAM_COUNT]     = { PARAM_TABLE(PARAM_MAX_) };
+static const uint32_t param_step[PARAM_COUNT]    = { PARAM_TABLE(PARAM_STEP_) };
+
+uint32_t                 param_shadow[PARAM_COUNT] = { PARAM_TABLE(PARAM_DEFAULT_) };
+volatile uint32_t        param_version = 0;
+param_stats_t            param_stats;
+volatile param_request_t param_request;
+
+#define PARAM_NO_PAGE       2U
+
+static uint32_t active_page = PARAM_NO_PAGE;    // 0, 1 or PARAM_NO_PAGE (blank store)
+static uint8_t  lane_fill[PARAM_COUNT];         // programmed slots per lane
+
+static volatile uint8_t param_ecc_hit;          // set by NMI_Handler during flash_read()
+static uint8_t          dcache_on;              // DCEN before flash_unlock()
+
+#define FLASH_KEY1          0x45670123U
+#define FLASH_KEY2          0xCDEF89ABU
+#define FLASH_SR_ERRORS     (FLASH_SR_OPERR | FLASH_SR_PROGERR | FLASH_SR_WRPERR |          \
+                             FLASH_SR_PGAERR | FLASH_SR_SIZERR | FLASH_SR_PGSERR |          \
+                             FLASH_SR_MISERR | FLASH_SR_FASTERR | FLASH_SR_RDERR |          \
+                             FLASH_SR_OPTVERR)
+
+//-------------------------------------------------------------------------------------------
+//  Flash access
+//-------------------------------------------------------------------------------------------
+static inline volatile uint32_t *slot_addr(uint32_t page, uint32_t dword) {
+    return (volatile uint32_t *)(FLASH_BASE + PARAM_FLASH_OFFSET +
+                                 page * PARAM_PAGE_SIZE + dword * 8U);
+}
+
+static inline uint32_t lane_dword(uint32_t id, uint32_t slot) {
+    return 1U + id * PARAM_LANE_SLOTS + slot;
+}
+
+// One double word of the store. Returns 0 if it read with a double ECC error: the words
+// are garbage (NMI_Handler flagged the read).
+static uint8_t flash_read(uint32_t page, uint32_t dword, uint32_t *lo, uint32_t *hi) {
+
+    volatile uint32_t *p = slot_addr(page, dword);
+
+    param_ecc_hit = 0;
+    *lo = p[0];
+    *hi = p[1];
+    __DSB();            // both reads done: the NMI of an ECC error on them has been taken
+    return !param_ecc_hit;
+}
+
+// A double word that reads with an ECC error was programmed (torn): not erased
+static inline uint8_t slot_erased(uint32_t page, uint32_t dword) {
+
+    uint32_t lo, hi;
+
+    param_stats.boot_reads++;
+    return flash_read(page, dword, &lo, &hi) && lo == 0xFFFFFFFFU && hi == 0xFFFFFFFFU;
+}
+
+// CRC-16/CCITT-FALSE over value (little endian), id and tag
+static uint16_t record_crc(uint32_t id, uint32_t value) {
+
+    uint8_t  bytes[6] = { (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16),
+                          (uint8_t)(value >> 24), (uint8_t)id, PARAM_RECORD_TAG };
+    uint16_t crc = 0xFFFFU;
+
+    for (uint32_t i = 0; i < sizeof(bytes); i++) {
+        crc ^= (uint16_t)bytes[i] << 8;
+        for (uint32_t b = 0; b < 8U; b++) {
+            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static inline uint32_t record_hi(uint32_t id, uint32_t value) {
+    return id | (PARAM_RECORD_TAG << 8) | ((uint32_t)record_crc(id, value) << 16);
+}
+
+static uint8_t value_valid(uint32_t id, uint32_t value) {
+    return value >= param_min[id] && value <= param_max[id] && value % param_step[id] == 0U;
+}
+
+static uint8_t flash_wait(void) {
+
+    while (FLASH->SR & FLASH_SR_BSY) {
+    }
+    if (FLASH->SR & FLASH_SR_ERRORS) {
+        FLASH->SR = FLASH_SR_ERRORS;
+        return 0;
+    }
+    FLASH->SR = FLASH_SR_EOP;
+    return 1;
+}
+
+// The flash data cache may hold the old contents of an erased or programmed line (the
+// boot load read both pages): it is off and emptied from unlock to lock, so the read-back
+// checks see the flash itself. DCRST only works with DCEN clear.
+static void flash_unlock(void) {
+
+    dcache_on   = (FLASH->ACR & FLASH_ACR_DCEN) != 0U;
+    FLASH->ACR &= ~FLASH_ACR_DCEN;
+    FLASH->ACR |=  FLASH_ACR_DCRST;
+    FLASH->ACR &= ~FLASH_ACR_DCRST;
+
+    if (FLASH->CR & FLASH_CR_LOCK) {
+        FLASH->KEYR = FLASH_KEY1;
+        FLASH->KEYR = FLASH_KEY2;
+    }
+    FLASH->SR = FLASH_SR_ERRORS | FLASH_SR_EOP;     // stale flags block programming
+}
+
+static void flash_lock(void) {
+
+    FLASH->CR |= FLASH_CR_LOCK;
+    if (dcache_on) {
+        FLASH->ACR |= FLASH_ACR_DCEN;
+    }
+}
+
+// Erase one page of the store (bank 2)
+static uint8_t flash_erase(uint32_t page) {
+
+    uint8_t ok;
+
+    FLASH->CR = (FLASH->CR & ~(FLASH_CR_PNB | FLASH_CR_PG)) | FLASH_CR_PER | FLASH_CR_BKER |
+                ((PARAM_FLASH_PAGE + page) << FLASH_CR_PNB_Pos);
+    FLASH->CR |= FLASH_CR_STRT;
+    ok = flash_wait();
+    FLASH->CR &= ~(FLASH_CR_PER | FLASH_CR_BKER);
+    return ok;
+}
+
+// Program one double word: both words, low address first, then wait for the write
+static uint8_t flash_program(uint32_t page, uint32_t dword, uint32_t lo, uint32_t hi) {
+
+    volatile uint32_t *p = slot_addr(page, dword);
+    uint32_t rlo, rhi;
+    uint8_t  ok;
+
+    FLASH->CR |= FLASH_CR_PG;
+    p[0] = lo;
+    p[1] = hi;
+    ok = flash_wait();
+    FLASH->CR &= ~FLASH_CR_PG;
+
+    param_stats.writes++;
+    return ok && flash_read(page, dword, &rlo, &rhi) && rlo == lo && rhi == hi;
+}
+
+//-------------------------------------------------------------------------------------------
+//  page_generation
+//  Generation of a page with a complete header, 0 otherwise (an ECC error in the header
+//  leaves the other page in use).
+//-------------------------------------------------------------------------------------------
+static uint32_t page_generation(uint32_t page) {
+
+    uint32_t magic, gen;
+
+    param_stats.boot_reads++;
+    if (!flash_read(page, 0, &magic, &gen) || magic != PARAM_MAGIC || gen == 0xFFFFFFFFU) {
+        return 0;
+    }
+    return gen;
+}
+
+//-------------------------------------------------------------------------------------------
+//  lane_load
+//  Slots are programmed in order, so the programmed ones are a prefix of the lane: find
+//  its length by binary search, then take the newest record that checks out.
+//-------------------------------------------------------------------------------------------
+static void lane_load(uint32_t page, uint32_t id) {
+
+    uint32_t lo = 0, hi = PARAM_LANE_SLOTS;     // first erased slot is in [lo, hi]
+
+    // 1. Length of the programmed prefix
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2U;
+        if (slot_erased(page, lane_dword(id, mid))) {
+            hi = mid;
+        }
+        else {
+            lo = mid + 1U;
+        }
+    }
+    lane_fill[id] = (uint8_t)lo;
+
+    // 2. Newest valid record, skipping torn (CRC or ECC) or foreign ones
+    for (uint32_t slot = lo; slot-- > 0U; ) {
+        uint32_t value, hi;
+        param_stats.boot_reads++;
+        if (flash_read(page, lane_dword(id, slot), &value, &hi) &&
+            hi == record_hi(id, value) && value_valid(id, value)) {
+            param_shadow[id] = value;
+            return;
+        }
+        param_stats.bad_records++;
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  compact
+//  Copy the current values (with 'id' = 'value') to the other page, header last.
+//-------------------------------------------------------------------------------------------
+static uint8_t compact(uint32_t id, uint32_t value) {
+
+    uint32_t target = (active_page == 0U) ? 1U : 0U;
+    uint32_t gen    = param_stats.generation + 1U;
+
+    param_stats.compactions++;
+
+    // 1. Erase the target page (the older one)
+    if (!flash_erase(target)) {
+        return 0;
+    }
+
+    // 2. One record per lane
+    for (uint32_t i = 0; i < PARAM_COUNT; i++) {
+        uint32_t v = (i == id) ? value : param_shadow[i];
+        if (!flash_program(target, lane_dword(i, 0), v, record_hi(i, v))) {
+            return 0;
+        }
+    }
+
+    // 3. Commit: the header makes the page the newest valid one. Until then a reset or a
+    //    failure leaves the old page in use, and its lanes as they were.
+    if (!flash_program(target, 0, PARAM_MAGIC, gen)) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < PARAM_COUNT; i++) {
+        lane_fill[i] = 1U;
+    }
+    active_page            = target;
+    param_stats.generation = gen;
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------
+//  Param_Init
+//-------------------------------------------------------------------------------------------
+void Param_Init(void) {
+
+    uint32_t gen0, gen1;
+
+    param_stats.boot_reads = 0;
+
+    // 1. Active page: the valid header with the higher generation
+    gen0 = page_generation(0);
+    gen1 = page_generation(1);
+
+    if (gen0 == 0U && gen1 == 0U) {
+        active_page            = PARAM_NO_PAGE;     // blank: defaults until the first Param_Set
+        param_stats.generation = 0;
+        return;
+    }
+    active_page            = (gen1 > gen0) ? 1U : 0U;
+    param_stats.generation = (gen1 > gen0) ? gen1 : gen0;
+
+    // 2. Newest record of each parameter
+    for (uint32_t id = 0; id < PARAM_COUNT; id++) {
+        lane_load(active_page, id);
+    }
+    param_version++;
+}
+
+//-------------------------------------------------------------------------------------------
+//  Param_Set
+//-------------------------------------------------------------------------------------------
+uint8_t Param_Set(uint32_t id, uint32_t value) {
+
+    uint8_t ok;
+
+    // 1. Validate; an unchanged value costs no flash write
+    if (id >= PARAM_COUNT || !value_valid(id, value)) {
+        param_stats.errors++;
+        return 0;
+    }
+    if (value == param_shadow[id]) {
+        return 1;       // a blank store holds the defaults
+    }
+
+    // 2. Append to the lane, or move to the other page when there is no room
+    flash_unlock();
+    if (active_page == PARAM_NO_PAGE || lane_fill[id] >= PARAM_LANE_SLOTS) {
+        ok = compact(id, value);
+    }
+    else {
+        ok = flash_program(active_page, lane_dword(id, lane_fill[id]), value,
+                           record_hi(id, value));
+        if (ok) {
+            lane_fill[id]++;
+        }
+        else {
+            // The failed slot may have stayed erased: a record after it would break the
+            // programmed prefix lane_load() searches. Move to the other page instead,
+            // and never append to this lane again.
+            param_stats.errors++;
+            lane_fill[id] = PARAM_LANE_SLOTS;
+            ok = compact(id, value);
+        }
+    }
+    flash_lock();
+
+    if (!ok) {
+        param_stats.errors++;
+        return 0;
+    }
+
+    // 3. Apply
+    param_shadow[id] = value;
+    param_version++;
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------
+//  Param_Task
+//-------------------------------------------------------------------------------------------
+void Param_Task(void) {
+
+    if (!param_request.pending || Arming_GetState() != ARMING_STATE_DISARMED) {
+        return;
+    }
+    param_request.status  = Param_Set(param_request.id, param_request.value);
+    param_request.pending = 0;
+}
+
+//-------------------------------------------------------------------------------------------
+//  NMI_Handler
+//  The flash raises the NMI on a double ECC error. In the store it is expected (a double
+//  word torn by a reset): clear it and let flash_read() drop the double word. Anywhere
+//  else the code or its constants are corrupt: stop.
+//-------------------------------------------------------------------------------------------
+void NMI_Handler(void) {
+
+    uint32_t eccr   = FLASH->ECCR;
+    uint32_t offset = ((eccr & FLASH_ECCR_BK_ECC) ? PARAM_BANK_SIZE : 0U) +
+                      (eccr & FLASH_ECCR_ADDR_ECC);
+
+    if ((eccr & FLASH_ECCR_ECCD) && !(eccr & FLASH_ECCR_SYSF_ECC) &&
+        offset >= PARAM_FLASH_OFFSET && offset < PARAM_FLASH_OFFSET + 2U * PARAM_PAGE_SIZE) {
+        FLASH->ECCR = (eccr & FLASH_ECCR_ECCIE) | FLASH_ECCR_ECCD;     // write 1 to clear
+        param_ecc_hit = 1;
+        param_stats.ecc_errors++;
+        return;
+    }
+    Fault_Stop();
+}
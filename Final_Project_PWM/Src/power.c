@@ -0,0 +1,89 @@
+/*
+ * power.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+#include "power.h"
+#include "arming.h"
+#include "button.h"
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+volatile power_stats_t power_stats = {0};
+
+static uint32_t last_cyccnt = 0;
+
+//-------------------------------------------------------------------------------------------
+//  Power_Init
+//  Enable the PWR interface clock and start the DWT cycle counter.
+//-------------------------------------------------------------------------------------------
+void Power_Init(void) {
+
+    // 1. Enable the clock of the PWR interface (needed to program PWR_CR1.LPMS)
+    RCC->APB1ENR1 |= RCC_APB1ENR1_PWREN;
+
+    // 2. Select Stop 2 as the deep-sleep mode: LPMS[2:0] = 010
+    PWR->CR1 &= ~PWR_CR1_LPMS;
+    PWR->CR1 |=  PWR_CR1_LPMS_STOP2;
+
+    // 3. Start the DWT cycle counter for awake-time accounting. Not reset: the profile
+    //    probes and the latency mode share it, and only deltas are used here.
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+    last_cyccnt       = DWT->CYCCNT;
+
+    // 4. No wake-up measured yet
+    power_stats.wake_cycles_min = UINT32_MAX;
+}
+
+//-------------------------------------------------------------------------------------------
+//  Power_Idle
+//  Account the cycles spent awake since the last call, then wait for an interrupt.
+//  Called from the main loop with interrupts masked once no task is pending: WFI
+//  still wakes on a pending interrupt, and its handler runs when main unmasks.
+//-------------------------------------------------------------------------------------------
+void Power_Idle(void) {
+
+    // 1. Awake time since the last idle entry (includes every handler that ran)
+    uint32_t now = DWT->CYCCNT;
+    power_stats.awake_cycles += now - last_cyccnt;
+    last_cyccnt = now;
+
+    // 2. DISARMED: optionally drop to Stop 2; EXTI13 (button) wakes the core.
+    //    Not while the button is being debounced: TIM6 would freeze with EXTI13 masked.
+    if (POWER_STOP2_WHEN_DISARMED && Arming_GetState() == ARMING_STATE_DISARMED &&
+        !button_Busy()) {
+        power_stats.stop2_entries++;
+
+        SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+        __DSB();
+        __WFI();
+        SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+
+        // MSI (4 MHz) is the wake-up clock (RCC_CFGR.STOPWUCK = 0), nothing to restore
+        return;
+    }
+
+    // 3. ARMED / ARMING: Sleep mode, peripherals keep running
+    uint32_t tick_pending = SCB->ICSR & SCB_ICSR_PENDSTSET_Msk;
+
+    power_stats.sleep_entries++;
+    __DSB();
+    __WFI();
+
+    // 4. Woken by SysTick (pending now, not before WFI): VAL has counted down from LOAD
+    //    since the event, one cycle after it reached 0
+    if (!tick_pending && (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)) {
+        uint32_t cycles = SysTick->LOAD - SysTick->VAL + 1U;
+
+        power_stats.wake_samples++;
+        power_stats.wake_cycles_last = cycles;
+        if (cycles < power_stats.wake_cycles_min) {
+            power_stats.wake_cycles_min = cycles;
+        }
+        if (cycles > power_stats.wake_cycles_max) {
+            power_stats.wake_cycles_max = cycles;
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * profile.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+#include "profile.h"
+#include "irq_config.h"
+#include "mem_sections.h"
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+#if PROFILE_ENABLE
+
+profile_probe_t profile_probes[PROF_COUNT];
+
+//-------------------------------------------------------------------------------------------
+//  Profile_Init
+//-------------------------------------------------------------------------------------------
+void Profile_Init(void) {
+
+    // 1. Enable the DWT unit and its cycle counter (shared with power.c)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+    // 2. Start from empty statistics
+    Profile_Reset();
+}
+
+//-------------------------------------------------------------------------------------------
+//  Profile_Reset
+//-------------------------------------------------------------------------------------------
+void Profile_Reset(void) {
+
+    uint32_t lock = Irq_Lock(IRQ_PRIO_PROTECTION);
+
+    for (uint32_t i = 0; i < PROF_COUNT; i++) {
+        profile_probes[i] = (profile_probe_t){0};
+        profile_probes[i].min = UINT32_MAX;
+    }
+
+    Irq_Unlock(lock);
+}
+
+//-------------------------------------------------------------------------------------------
+//  Profile_Record
+//  A probe can be hit from more than one context (PWM_SetPulse_us runs in the control
+//  task and in the button ISR), so the update runs under the BASEPRI lock.
+//-------------------------------------------------------------------------------------------
+RAMFUNC void Profile_Record(uint32_t id, uint32_t cycles) {
+
+    profile_probe_t *p    = &profile_probes[id];
+    uint32_t         bin  = 31U - (uint32_t)__builtin_clz(cycles | 1U);
+    uint32_t         lock = Irq_Lock(IRQ_PRIO_PROTECTION);
+
+    p->count++;
+    p->sum += cycles;
+    if (cycles < p->min) {
+        p->min = cycles;
+    }
+    if (cycles > p->max) {
+        p->max = cycles;
+    }
+    p->hist[bin]++;
+
+    Irq_Unlock(lock);
+}
+
+//-------------------------------------------------------------------------------------------
+//  Profile_Mean
+//-------------------------------------------------------------------------------------------
+uint32_t Profile_Mean(uint32_t id) {
+
+    profile_probe_t *p = &profile_probes[id];
+
+    return (p->count != 0) ? (uint32_t)(p->sum / p->count) : 0;
+}
+
+#endif /* PROFILE_ENABLE */
@@ -0,0 +1,108 @@
+/*
+ * scheduler.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+#include "scheduler.h"
+#include "tasks.h"
+#include "timebase.h"
+#include "mem_sections.h"
+#include "trace.h"
+#include <stdint.h>
+
+volatile uint32_t scheduler_ticks = 0;   // ms since Scheduler_Init()
+task_stats_t      task_stats[TASK_COUNT];
+
+static uint32_t next_release[TASK_COUNT];
+
+//-------------------------------------------------------------------------------------------
+//  Scheduler_Init
+//-------------------------------------------------------------------------------------------
+void Scheduler_Init(void) {
+
+    scheduler_ticks = 0;
+
+    for (uint32_t i = 0; i < task_count; i++) {
+        next_release[i] = task_table[i].offset_ms;
+        task_stats[i]   = (task_stats_t){0};
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  Scheduler_Tick
+//  Called from SysTick_Handler at 1 kHz. Constant time: no task work in the ISR.
+//-------------------------------------------------------------------------------------------
+RAMFUNC void Scheduler_Tick(void) {
+
+    scheduler_ticks++;
+}
+
+//-------------------------------------------------------------------------------------------
+//  Scheduler_Pending
+//-------------------------------------------------------------------------------------------
+uint8_t Scheduler_Pending(void) {
+
+    uint32_t now = scheduler_ticks;
+
+    for (uint32_t i = 0; i < task_count; i++) {
+        if ((int32_t)(now - next_release[i]) >= 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------
+//  Scheduler_Run
+//  Rate-monotonic, cooperative dispatch: scan the table from the fastest task and
+//  restart the scan after every run, so a fast task released while a slow one was
+//  running goes next.
+//-------------------------------------------------------------------------------------------
+void Scheduler_Run(void) {
+
+    uint32_t i = 0;
+
+    while (i < task_count) {
+
+        const task_t  *task  = &task_table[i];
+        task_stats_t  *stats = &task_stats[i];
+        uint32_t       now   = scheduler_ticks;
+        uint32_t       late  = now - next_release[i];
+
+        // 1. Not released yet: look at the next (slower) task
+        if ((int32_t)late < 0) {
+            i++;
+            continue;
+        }
+
+        // 2. Late by one or more whole periods: drop the missed releases
+        if (late >= task->period_ms) {
+            uint32_t missed = late / task->period_ms;
+            stats->skipped  += missed;
+            next_release[i] += missed * task->period_ms;
+            late            -= missed * task->period_ms;
+        }
+        if (late > stats->max_lateness_ms) {
+            stats->max_lateness_ms = late;
+        }
+
+        // 3. Run to completion and measure
+        uint64_t start = now_cycles();
+        task->run();
+        uint32_t exec  = (uint32_t)(now_cycles() - start);
+
+        stats->runs++;
+        if (exec > stats->max_exec_cycles) {
+            stats->max_exec_cycles = exec;
+        }
+        if (scheduler_ticks - next_release[i] > task->deadline_ms) {
+            stats->overruns++;
+            Trace_Record(TRACE_ID_TASK_OVERRUN, (uint16_t)i);
+        }
+
+        // 4. Next release, then rescan from the highest rate
+        next_release[i] += task->period_ms;
+        i = 0;
+    }
+}
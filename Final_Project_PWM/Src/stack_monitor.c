@@ -0,0 +1,109 @@
+/*
+ * stack_monitor.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+#include "stack_monitor.h"
+#include "board_config.h"
+#include "param_store.h"
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+// Linker script symbols (STM32L476RGTX_FLASH.ld / _RAM.ld)
+extern uint32_t _sstack;
+extern uint32_t _estack;
+extern uint32_t _Stack_Guard_Size;
+
+volatile stack_fault_t stack_fault;
+
+//-------------------------------------------------------------------------------------------
+//  StackMonitor_Init
+//-------------------------------------------------------------------------------------------
+void StackMonitor_Init(void) {
+
+    if (!STACK_MPU_GUARD) {
+        return;
+    }
+
+    // 1. Guard band: no access, never executable, 32 bytes at _sstack
+    ARM_MPU_Disable();
+    ARM_MPU_SetRegion(ARM_MPU_RBAR(STACK_GUARD_REGION, (uint32_t)&_sstack),
+                      ARM_MPU_RASR(1U, ARM_MPU_AP_NONE, 0U, 0U, 0U, 0U, 0U,
+                                   ARM_MPU_REGION_SIZE_32B));
+
+    // 2. Default memory map everywhere else (privileged code only in this firmware).
+    //    HFNMIENA stays 0: the MPU is off inside HardFault, so the handler can still
+    //    run after a fault that left the SP in the guard band.
+    ARM_MPU_Enable(MPU_CTRL_PRIVDEFENA_Msk);
+
+    // 3. Report guard hits as MemManage faults
+    SCB->SHCSR |= SCB_SHCSR_MEMFAULTENA_Msk;
+}
+
+//-------------------------------------------------------------------------------------------
+//  StackMonitor_HighWater
+//-------------------------------------------------------------------------------------------
+uint32_t StackMonitor_HighWater(void) {
+
+    const uint32_t *p   = (const uint32_t *)((uint32_t)&_sstack + (uint32_t)&_Stack_Guard_Size);
+    const uint32_t *end = &_estack;
+
+    // 1. Skip the words that still hold the paint
+    while (p < end && *p == STACK_PAINT_WORD) {
+        p++;
+    }
+
+    // 2. Everything above is (or was) in use
+    return (uint32_t)end - (uint32_t)p;
+}
+
+//-------------------------------------------------------------------------------------------
+//  StackMonitor_Size
+//-------------------------------------------------------------------------------------------
+uint32_t StackMonitor_Size(void) {
+
+    return (uint32_t)&_estack - (uint32_t)&_sstack - (uint32_t)&_Stack_Guard_Size;
+}
+
+//-------------------------------------------------------------------------------------------
+//  Fault_Stop
+//  Last resort for any fault: hold the ESC at the stop pulse and halt. TIM2 keeps
+//  generating the 1000 us pulse without the CPU. Registers only, no calls: the stack
+//  may be exhausted.
+//-------------------------------------------------------------------------------------------
+void Fault_Stop(void) {
+
+    __disable_irq();
+
+    // 1. Capture the cause for the debugger
+    stack_fault.cfsr  = SCB->CFSR;
+    stack_fault.mmfar = SCB->MMFAR;
+    stack_fault.sp    = __get_MSP();
+
+    // 2. ESC stop pulse from the next frame on (20 us per count, see PWM_SetPulse_us).
+    //    The shadow is read directly: Param_Get() is a call in the -O0 build.
+    TIM2->CCR1 = PWM_US_TO_COUNTS(param_shadow[PARAM_PULSE_MIN_US]);
+
+    while (1) {
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  MemManage_Handler
+//  Stack overflow into the guard band. If stacking the exception frame itself faulted
+//  (MSTKERR), this handler's own pushes escalate to HardFault, which lands in the same
+//  place with the MPU disabled.
+//-------------------------------------------------------------------------------------------
+void MemManage_Handler(void) {
+
+    Fault_Stop();
+}
+
+//-------------------------------------------------------------------------------------------
+//  HardFault_Handler
+//-------------------------------------------------------------------------------------------
+void HardFault_Handler(void) {
+
+    Fault_Stop();
+}
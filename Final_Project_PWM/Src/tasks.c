@@ -0,0 +1,138 @@
+/*
+ * tasks.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+#include "tasks.h"
+#include "scheduler.h"
+#include "control.h"
+#include "ADC.h"
+#include "PWM.h"
+#include "LED.h"
+#include "power.h"
+#include "timer_wheel.h"
+#include "button.h"
+#include "arming.h"
+#include "irq_config.h"
+#include "latency.h"
+#include "trace.h"
+#include "stack_monitor.h"
+#include "param_store.h"
+#include <stdint.h>
+
+volatile telemetry_t telemetry = {0};
+
+//-------------------------------------------------------------------------------------------
+//  Task table (rate-monotonic order, see scheduler.h)
+//  Offsets keep the slower tasks off the ticks where the next faster one is released.
+//-------------------------------------------------------------------------------------------
+const task_t task_table[TASK_COUNT] = {
+    //  name          run              period                     offset  deadline
+    { "control",   Control_Task,   TASK_CONTROL_PERIOD_MS,     0,      1   },
+    { "timers",    Timers_Task,    TASK_TIMERS_PERIOD_MS,      0,      1   },
+    { "arming",    Arming_Task,    TASK_ARMING_PERIOD_MS,      0,      1   },
+    { "trace",     Trace_Task,     TASK_TRACE_PERIOD_MS,       1,      10  },
+    { "heartbeat", Heartbeat_Task, TASK_HEARTBEAT_PERIOD_MS,   2,      20  },
+    { "params",    Param_Task,     TASK_PARAMS_PERIOD_MS,      4,      100 },
+    { "telemetry", Telemetry_Task, TASK_TELEMETRY_PERIOD_MS,   3,      100 },
+};
+
+const uint32_t task_count = TASK_COUNT;
+
+//-------------------------------------------------------------------------------------------
+//  Control_Task
+//  Apply the newest sample queued by ADC1_2_IRQHandler (one per 20 ms PWM frame).
+//  CCR1 is preloaded, so committing up to 1 ms after the sample does not delay the
+//  output: the new pulse still starts at the next frame boundary.
+//-------------------------------------------------------------------------------------------
+void Control_Task(void) {
+
+    uint16_t sample;
+    uint8_t  have_sample = 0;
+
+    while (adc_samples_pop(&adc_samples, &sample)) {
+        have_sample = 1;
+    }
+
+    if (have_sample) {
+        Control_Step(sample);
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  Timers_Task
+//  Feed the SysTick time into the timer wheel; expired callbacks run here.
+//-------------------------------------------------------------------------------------------
+void Timers_Task(void) {
+
+    TimerWheel_Advance(scheduler_ticks);
+}
+
+//-------------------------------------------------------------------------------------------
+//  Heartbeat_Task
+//    DISARMED : LED off
+//    ARMED    : toggle every PARAM_HEARTBEAT_MS (500 ms: 1 Hz blink)
+//-------------------------------------------------------------------------------------------
+void Heartbeat_Task(void) {
+
+    static uint32_t elapsed_ms = 0;
+
+    switch (Arming_GetState()) {
+    case ARMING_STATE_ARMED:
+        elapsed_ms += TASK_HEARTBEAT_PERIOD_MS;
+        if (elapsed_ms >= Param_Get(PARAM_HEARTBEAT_MS)) {
+            elapsed_ms = 0;
+            toggle_LED();
+        }
+        break;
+    case ARMING_STATE_DISARMED:
+        elapsed_ms = 0;
+        turn_off_LED();
+        break;
+    default:
+        elapsed_ms = 0;
+        break;      // ARMING: the arming blink timer owns the LED
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  Telemetry_Task
+//-------------------------------------------------------------------------------------------
+void Telemetry_Task(void) {
+
+    uint32_t       overruns = 0;
+    button_event_t ev;
+
+    while (button_events_pop(&button_events, &ev)) {
+        if (ev.type == BUTTON_EVENT_PRESS) {
+            telemetry.button_presses++;
+            telemetry.last_press_us = ev.time_us;
+        }
+        else {
+            telemetry.last_gesture = ev.type;
+        }
+    }
+
+    for (uint32_t i = 0; i < task_count; i++) {
+        overruns += task_stats[i].overruns;
+    }
+
+    // One interrupt latency probe per second, while everything else keeps running
+    Irq_LatencyProbe();
+
+    // Input-to-output latency of the frames since the last snapshot
+    if (LATENCY_MEASURE) {
+        Latency_Report();
+    }
+
+    telemetry.uptime_ms     = scheduler_ticks;
+    telemetry.throttle      = (uint16_t)adc_result;
+    telemetry.pulse_counts  = pwm_duty;
+    telemetry.state         = Arming_GetState();
+    telemetry.task_overruns = overruns;
+    telemetry.awake_cycles  = power_stats.awake_cycles;
+
+    telemetry.stack_high_water = StackMonitor_HighWater();
+    telemetry.stack_size       = StackMonitor_Size();
+}
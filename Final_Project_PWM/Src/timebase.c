@@ -0,0 +1,93 @@
+/*
+ * timebase.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+#include "timebase.h"
+#include "mem_sections.h"
+#include "irq_config.h"
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+// Upper 32 bits of the cycle count, incremented on every TIM5 overflow (~1073 s at 4 MHz)
+static volatile uint32_t tim5_overflows = 0;
+
+//-------------------------------------------------------------------------------------------
+//  Timebase_Init
+//  TIM5 is a 32-bit up-counter. With PSC = 0 it counts HCLK cycles and overflows
+//  every 2^32 / 4 MHz = 1073 s. DWT->CYCCNT is not used here because it stops while
+//  the core sleeps in WFI (see power.c), TIM5 does not.
+//-------------------------------------------------------------------------------------------
+void Timebase_Init(void) {
+
+    // 1. Enable clock for TIM5 on APB1 bus
+    RCC->APB1ENR1 |= RCC_APB1ENR1_TIM5EN;
+
+    // 2. Free-running: count every timer clock, wrap at 0xFFFFFFFF
+    TIM5->CR1 = 0;
+    TIM5->PSC = 0;
+    TIM5->ARR = 0xFFFFFFFFU;
+
+    // 3. Load PSC/ARR, then clear the UIF set by the UG event
+    TIM5->EGR = TIM_EGR_UG;
+    TIM5->SR  = 0;
+    tim5_overflows = 0;
+
+    // 4. Enable the update (overflow) interrupt
+    TIM5->DIER |= TIM_DIER_UIE;
+    NVIC_EnableIRQ(TIM5_IRQn);
+
+    // 5. Enable the counter
+    TIM5->CR1 |= TIM_CR1_CEN;
+}
+
+//-------------------------------------------------------------------------------------------
+//  now_cycles
+//  Combine the overflow count with TIM5->CNT without locking:
+//    - retry if TIM5_IRQHandler ran while reading (overflow count changed);
+//    - if the counter wrapped but the handler has not run yet (caller has a higher
+//      priority or interrupts are masked), UIF is still pending and CNT is small,
+//      so account for the missing overflow here.
+//-------------------------------------------------------------------------------------------
+RAMFUNC uint64_t now_cycles(void) {
+
+    uint32_t hi, lo, pending;
+
+    do {
+        hi      = tim5_overflows;
+        lo      = TIM5->CNT;
+        pending = TIM5->SR & TIM_SR_UIF;
+    } while (hi != tim5_overflows);
+
+    if (pending && lo < 0x80000000U) {
+        hi++;
+    }
+
+    return ((uint64_t)hi << 32) | lo;
+}
+
+//-------------------------------------------------------------------------------------------
+//  now_us
+//-------------------------------------------------------------------------------------------
+RAMFUNC uint64_t now_us(void) {
+
+    return now_cycles() / TIMEBASE_CYCLES_PER_US;
+}
+
+//-------------------------------------------------------------------------------------------
+//  TIM5_IRQHandler
+//-------------------------------------------------------------------------------------------
+RAMFUNC void TIM5_IRQHandler(void) {
+
+    Irq_Entry(IRQ_SLOT_TIMEBASE);
+
+    // Clear UIF and count the overflow with interrupts masked: a higher-priority ISR
+    // calling now_cycles() between the two would see neither (2^32 cycles in the past)
+    __disable_irq();
+    if (TIM5->SR & TIM_SR_UIF) {
+        TIM5->SR = (uint32_t)~TIM_SR_UIF;    // Clear UIF only (rc_w0)
+        tim5_overflows++;
+    }
+    __enable_irq();
+}
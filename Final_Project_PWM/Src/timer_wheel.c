@@ -0,0 +1,180 @@
+/*
+ * timer_wheel.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+#include "timer_wheel.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define SLOT_MASK          (TIMER_WHEEL_SLOTS - 1U)
+#define LEVEL_SHIFT(n)     ((n) * TIMER_WHEEL_BITS)
+#define LEVEL_RANGE(n)     (1UL << LEVEL_SHIFT((n) + 1))    // ticks covered by levels 0..n
+#define MAX_DELAY          (LEVEL_RANGE(TIMER_WHEEL_LEVELS - 1) - 1U)
+
+static soft_timer_t *wheel[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+static uint32_t      wheel_tick;    // next tick to be processed
+
+//-------------------------------------------------------------------------------------------
+//  List helpers: singly linked forward, 'pprev' points at whatever points to us,
+//  so unlinking needs no list head and no search.
+//-------------------------------------------------------------------------------------------
+static void list_add(soft_timer_t **head, soft_timer_t *timer) {
+
+    timer->next  = *head;
+    timer->pprev = head;
+    if (*head != NULL) {
+        (*head)->pprev = &timer->next;
+    }
+    *head = timer;
+}
+
+static void list_del(soft_timer_t *timer) {
+
+    *timer->pprev = timer->next;
+    if (timer->next != NULL) {
+        timer->next->pprev = timer->pprev;
+    }
+    timer->next  = NULL;
+    timer->pprev = NULL;
+}
+
+//-------------------------------------------------------------------------------------------
+//  wheel_insert
+//  Pick the level from the distance to the current tick and the slot from the bits of
+//  the expiry time that belong to that level.
+//-------------------------------------------------------------------------------------------
+static void wheel_insert(soft_timer_t *timer) {
+
+    uint32_t expires = timer->expires;
+    int32_t  delta   = (int32_t)(expires - wheel_tick);
+    uint32_t level;
+
+    if (delta < 0) {
+        expires = wheel_tick;       // already due: fire on the next processed tick
+        delta   = 0;
+    }
+    if ((uint32_t)delta > MAX_DELAY) {
+        expires = wheel_tick + MAX_DELAY;
+    }
+
+    for (level = 0; level < TIMER_WHEEL_LEVELS - 1U; level++) {
+        if ((uint32_t)delta < LEVEL_RANGE(level)) {
+            break;
+        }
+    }
+
+    list_add(&wheel[level][(expires >> LEVEL_SHIFT(level)) & SLOT_MASK], timer);
+}
+
+//-------------------------------------------------------------------------------------------
+//  cascade
+//  Move every timer of one upper-level slot down to where it belongs now.
+//  Returns the slot index, which is 0 when the next level must cascade as well.
+//-------------------------------------------------------------------------------------------
+static uint32_t cascade(uint32_t level) {
+
+    uint32_t      index = (wheel_tick >> LEVEL_SHIFT(level)) & SLOT_MASK;
+    soft_timer_t *timer = wheel[level][index];
+
+    wheel[level][index] = NULL;
+
+    while (timer != NULL) {
+        soft_timer_t *next = timer->next;
+        wheel_insert(timer);
+        timer = next;
+    }
+    return index;
+}
+
+//-------------------------------------------------------------------------------------------
+//  TimerWheel_Init
+//-------------------------------------------------------------------------------------------
+void TimerWheel_Init(uint32_t now) {
+
+    for (uint32_t level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (uint32_t slot = 0; slot < TIMER_WHEEL_SLOTS; slot++) {
+            wheel[level][slot] = NULL;
+        }
+    }
+    wheel_tick = now;
+}
+
+//-------------------------------------------------------------------------------------------
+//  TimerWheel_Start
+//-------------------------------------------------------------------------------------------
+void TimerWheel_Start(soft_timer_t *timer, uint32_t delay_ms, uint32_t period_ms,
+                      soft_timer_fn_t callback) {
+
+    if (timer->pprev != NULL) {
+        list_del(timer);
+    }
+
+    timer->expires  = wheel_tick + delay_ms;
+    timer->period   = period_ms;
+    timer->callback = callback;
+    wheel_insert(timer);
+}
+
+//-------------------------------------------------------------------------------------------
+//  TimerWheel_Stop
+//-------------------------------------------------------------------------------------------
+void TimerWheel_Stop(soft_timer_t *timer) {
+
+    if (timer->pprev != NULL) {
+        list_del(timer);
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  TimerWheel_IsActive
+//-------------------------------------------------------------------------------------------
+uint8_t TimerWheel_IsActive(const soft_timer_t *timer) {
+
+    return timer->pprev != NULL;
+}
+
+//-------------------------------------------------------------------------------------------
+//  TimerWheel_Advance
+//  Per tick: one slot of level 0 is emptied, and every 64 ticks one slot of level 1
+//  (every 4096 ticks one of level 2) is redistributed. The cost does not depend on how
+//  many timers are armed, only on how many expire in that tick.
+//-------------------------------------------------------------------------------------------
+void TimerWheel_Advance(uint32_t now) {
+
+    while ((int32_t)(now - wheel_tick) >= 0) {
+
+        uint32_t index = wheel_tick & SLOT_MASK;
+
+        // 1. Level 0 wrapped: pull the next slot(s) of the upper levels down
+        if (index == 0) {
+            for (uint32_t level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+                if (cascade(level) != 0) {
+                    break;
+                }
+            }
+        }
+
+        // 2. Detach the expiring slot; callbacks may start or stop any timer,
+        //    including the ones still waiting in 'expired'
+        soft_timer_t *expired = wheel[0][index];
+        wheel[0][index] = NULL;
+        if (expired != NULL) {
+            expired->pprev = &expired;
+        }
+        wheel_tick++;
+
+        // 3. Run callbacks; periodic timers are re-armed first so a callback can stop them
+        while (expired != NULL) {
+            soft_timer_t *timer = expired;
+            list_del(timer);
+
+            if (timer->period != 0) {
+                timer->expires += timer->period;
+                wheel_insert(timer);
+            }
+            timer->callback(timer);
+        }
+    }
+}
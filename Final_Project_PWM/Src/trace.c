@@ -0,0 +1,135 @@
+/*
+ * trace.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ */
+#include "trace.h"
+#include "timebase.h"
+#include "stm32l476xx.h"
+#include <stdint.h>
+
+trace_buffer_t trace_buffer;
+
+static uint32_t trace_tail     = 0;     // next record to send over the UART
+static uint32_t trace_inflight = 0;     // records in the running DMA transfer
+static uint8_t  header_sent    = 0;
+
+//-------------------------------------------------------------------------------------------
+//  Trace_UART_Init
+//  USART2 TX on PA2 (AF7), 8N1, transmit DMA requests on DMA1 channel 7.
+//-------------------------------------------------------------------------------------------
+static void Trace_UART_Init(void) {
+
+    // 1. Enable the clocks of USART2 and DMA1
+    //    (PA2 is Alternate Function AF7 = USART2_TX when TRACE_UART, Board_Pins_Init)
+    RCC->APB1ENR1 |= RCC_APB1ENR1_USART2EN;
+    RCC->AHB1ENR  |= RCC_AHB1ENR_DMA1EN;
+
+    // 2. Baud rate from the 4 MHz clock (115200: BRR = 35, 0.8 % error)
+    USART2->CR1 = 0;
+    USART2->BRR = (TIMEBASE_CLOCK_HZ + TRACE_UART_BAUD / 2U) / TRACE_UART_BAUD;
+
+    // 3. Transmit through DMA, enable transmitter and USART
+    USART2->CR3 |= USART_CR3_DMAT;
+    USART2->CR1 |= USART_CR1_TE | USART_CR1_UE;
+
+    // 4. DMA1 channel 7 = USART2_TX (C7S = 0010), memory to peripheral, byte wide
+    DMA1_CSELR->CSELR &= ~DMA_CSELR_C7S;
+    DMA1_CSELR->CSELR |=  (2U << DMA_CSELR_C7S_Pos);
+    DMA1_Channel7->CCR  = DMA_CCR_MINC | DMA_CCR_DIR;
+    DMA1_Channel7->CPAR = (uint32_t)&USART2->TDR;
+}
+
+//-------------------------------------------------------------------------------------------
+//  Trace_Init
+//-------------------------------------------------------------------------------------------
+void Trace_Init(void) {
+
+    // 1. Header for the debugger dump / UART stream
+    trace_buffer.header.magic       = TRACE_MAGIC;
+    trace_buffer.header.version     = TRACE_VERSION;
+    trace_buffer.header.record_size = sizeof(trace_record_t);
+    trace_buffer.header.capacity    = TRACE_RECORDS;
+    trace_buffer.header.clock_hz    = TIMEBASE_CLOCK_HZ;
+    trace_buffer.header.head        = 0;
+    trace_buffer.header.lost        = 0;
+
+    // 2. Optional UART link
+    if (TRACE_UART) {
+        Trace_UART_Init();
+    }
+}
+
+//-------------------------------------------------------------------------------------------
+//  start_dma
+//-------------------------------------------------------------------------------------------
+static void start_dma(const void *src, uint32_t bytes) {
+
+    DMA1_Channel7->CMAR  = (uint32_t)src;
+    DMA1_Channel7->CNDTR = bytes;
+    DMA1_Channel7->CCR  |= DMA_CCR_EN;
+}
+
+//-------------------------------------------------------------------------------------------
+//  Trace_Task
+//  Drain order: header once, then contiguous runs of records (up to TRACE_DRAIN_MAX).
+//  Completion is polled, so the link needs no interrupt. If the writers get too far
+//  ahead of the drain, the oldest records are skipped and a TRACE_ID_LOST record says
+//  how many.
+//-------------------------------------------------------------------------------------------
+void Trace_Task(void) {
+
+    if (!TRACE_UART) {
+        return;
+    }
+
+    // 1. Transfer still running?
+    if (DMA1_Channel7->CCR & DMA_CCR_EN) {
+        if (!(DMA1->ISR & DMA_ISR_TCIF7)) {
+            return;
+        }
+        DMA1->IFCR           = DMA_IFCR_CGIF7;
+        DMA1_Channel7->CCR  &= ~DMA_CCR_EN;
+        trace_tail          += trace_inflight;
+        trace_inflight       = 0;
+    }
+
+    // 2. Stream header first, so the decoder knows the record format and clock
+    if (!header_sent) {
+        header_sent = 1;
+        start_dma(&trace_buffer.header, sizeof(trace_header_t));
+        return;
+    }
+
+    // 3. Too far behind: skip to the newest TRACE_RECORDS - TRACE_DRAIN_MAX records, so
+    //    the writers cannot reach the run being sent before the transfer completes
+    uint32_t head = __atomic_load_n(&trace_buffer.header.head, __ATOMIC_ACQUIRE);
+    uint32_t keep = TRACE_RECORDS - TRACE_DRAIN_MAX;
+
+    if (head - trace_tail > keep) {
+        uint32_t lost = head - trace_tail - keep;
+
+        trace_buffer.header.lost += lost;
+        trace_tail                = head - keep;
+        Trace_Record(TRACE_ID_LOST, (lost > 0xFFFFU) ? 0xFFFFU : (uint16_t)lost);
+        head++;
+    }
+
+    // 4. Send the next contiguous run
+    uint32_t n     = head - trace_tail;
+    uint32_t start = trace_tail & (TRACE_RECORDS - 1U);
+
+    if (n == 0) {
+        return;
+    }
+    if (start + n > TRACE_RECORDS) {
+        n = TRACE_RECORDS - start;
+    }
+    if (n > TRACE_DRAIN_MAX) {
+        n = TRACE_DRAIN_MAX;
+    }
+
+    trace_inflight = n;
+    start_dma(&trace_buffer.records[start], n * sizeof(trace_record_t));
+}
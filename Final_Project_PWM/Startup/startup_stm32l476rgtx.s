@@ -41,6 +41,13 @@ defined in linker script */
 .word _sbss
 /* end address for the .bss section. defined in linker script */
 .word _ebss
+/* start address for the initialization values of the .sram2 section.
+defined in linker script */
+.word _sisram2
+/* start address for the .sram2 section. defined in linker script */
+.word _ssram2
+/* end address for the .sram2 section. defined in linker script */
+.word _esram2
 
 /**
  * @brief  This is the code that gets called when the processor first
@@ -57,6 +64,21 @@ defined in linker script */
 Reset_Handler:
   ldr   r0, =_estack
   mov   sp, r0          /* set stack pointer */
+
+/* Paint the MSP stack so its high-water mark can be found (stack_monitor.c) */
+  ldr r0, =_sstack
+  ldr r1, =_estack
+  ldr r2, =0xA5A5A5A5
+  b LoopPaintStack
+
+PaintStack:
+  str r2, [r0]
+  adds r0, r0, #4
+
+LoopPaintStack:
+  cmp r0, r1
+  bcc PaintStack
+
 /* Call the clock system initialization function.*/
   bl  SystemInit
 
@@ -77,6 +99,23 @@ LoopCopyDataInit:
   cmp r4, r1
   bcc CopyDataInit
 
+/* Copy the SRAM2 code and data (.ramfunc/.fastdata) from flash to SRAM2 */
+  ldr r0, =_ssram2
+  ldr r1, =_esram2
+  ldr r2, =_sisram2
+  movs r3, #0
+  b LoopCopySram2Init
+
+CopySram2Init:
+  ldr r4, [r2, r3]
+  str r4, [r0, r3]
+  adds r3, r3, #4
+
+LoopCopySram2Init:
+  adds r4, r0, r3
+  cmp r4, r1
+  bcc CopySram2Init
+
 /* Zero fill the bss segment. */
   ldr r2, =_sbss
   ldr r4, =_ebss
@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+#
+# bench_report.py
+#
+#  Created on: Oct 19, 2026
+#      Author: Elias Asami, Milton Salazar
+#
+# Per-commit history and regression check for the kernel microbenchmarks (Inc/bench.h).
+#
+# Input is Google Benchmark JSON from either side:
+#   - host  : Host/bench_host --benchmark_out=bench.json      (metric: cpu_time, ns/op)
+#   - target: bench_json dumped from a BENCH_ENABLE=1 build   (metric: DWT cycles/op)
+# A host result uses the median aggregate when there is one, else the fastest repetition.
+#
+# Every run is compared with the latest stored run of the same platform (and, for the
+# host, the same machine) from a different commit. Fails (exit 1) when a kernel got slower
+# by more than "max_regression_pct" for that platform in bench_history.json.
+#
+# Usage:
+#   python3 Tools/bench_report.py --input bench.json --history Tools/bench_history.json
+#   ... --record          store the run under the current commit (git rev-parse HEAD)
+
+import argparse
+import datetime
+import json
+import subprocess
+import sys
+
+
+def git(*args):
+    try:
+        return subprocess.run(('git',) + args, capture_output=True, text=True,
+                              check=True).stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return ''
+
+
+def load_results(path):
+    with open(path) as f:
+        data = json.load(f)
+    context = data.get('context', {})
+    platform = 'target' if context.get('host_name') == 'stm32l476rg' else 'host'
+
+    medians, fastest = {}, {}
+    for b in data.get('benchmarks', []):
+        name = b.get('run_name', b['name'])
+        entry = {'time_ns': b['cpu_time']}
+        if 'cycles_per_op' in b:
+            entry['cycles_per_op'] = b['cycles_per_op']
+        if b.get('run_type') == 'aggregate':
+            if b.get('aggregate_name') == 'median':
+                medians[name] = entry
+        elif name not in fastest or entry['time_ns'] < fastest[name]['time_ns']:
+            fastest[name] = entry
+    fastest.update(medians)
+    return platform, context.get('host_name', ''), fastest
+
+
+def metric(platform):
+    return ('cycles_per_op', 'cyc/op') if platform == 'target' else ('time_ns', 'ns/op')
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Microbenchmark history and regression check')
+    ap.add_argument('--input', required=True, help='Google Benchmark JSON')
+    ap.add_argument('--history', required=True, help='bench_history.json')
+    ap.add_argument('--record', action='store_true', help='store this run under HEAD')
+    args = ap.parse_args()
+
+    with open(args.history) as f:
+        history = json.load(f)
+    history.setdefault('runs', [])
+
+    platform, host, results = load_results(args.input)
+    key, unit = metric(platform)
+    commit = git('rev-parse', '--short=12', 'HEAD') or 'unknown'
+    if git('status', '--porcelain', '--untracked-files=no'):
+        commit += '-dirty'
+
+    # 1. Previous run of the same platform / machine, other commit
+    previous = None
+    for run in reversed(history['runs']):
+        if run['platform'] == platform and run['host_name'] == host and run['commit'] != commit:
+            previous = run
+            break
+
+    # 2. Per kernel
+    limit = history.get('max_regression_pct', {}).get(platform)
+    errors = []
+    print('%s (%s), commit %s, compared with %s' % (
+        platform, host, commit, previous['commit'] if previous else 'nothing'))
+    print('  Kernel              %12s   (prev)   change' % unit)
+    for name in sorted(set(results) | set(previous['results'] if previous else {})):
+        cur = results.get(name, {}).get(key)
+        old = previous['results'].get(name, {}).get(key) if previous else None
+        if cur is None:
+            print('  %-18s %12s  %8.2f   removed' % (name, '-', old))
+            continue
+        if old is None:
+            print('  %-18s %12.2f  %8s   new' % (name, cur, '-'))
+            continue
+        change = 100.0 * (cur - old) / old if old else 0.0
+        print('  %-18s %12.2f  %8.2f  %+6.1f%%' % (name, cur, old, change))
+        if limit is not None and change > limit:
+            errors.append('%s: %.2f -> %.2f %s (+%.1f%%, limit %.1f%%)' % (
+                name, old, cur, unit, change, limit))
+
+    if args.record:
+        history['runs'] = [r for r in history['runs']
+                           if not (r['platform'] == platform and r['host_name'] == host and
+                                   r['commit'] == commit)]
+        history['runs'].append({
+            'commit': commit,
+            'subject': git('log', '-1', '--format=%s'),
+            'date': datetime.datetime.now().isoformat(timespec='seconds'),
+            'platform': platform,
+            'host_name': host,
+            'results': results,
+        })
+        with open(args.history, 'w') as f:
+            json.dump(history, f, indent=2, sort_keys=True)
+            f.write('\n')
+        print('\nrecorded in %s' % args.history)
+
+    if errors:
+        print('\nFAILED:')
+        for e in errors:
+            print('  ' + e)
+        return 1
+    print('\nOK')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
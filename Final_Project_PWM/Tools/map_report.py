@@ -0,0 +1,291 @@
+#!/usr/bin/env python3
+#
+# map_report.py
+#
+#  Created on: Oct 19, 2026
+#      Author: Elias Asami, Milton Salazar
+#
+# Memory footprint report and regression check for the GNU ld map file.
+#
+# Every input section in "Linker script and memory map" is attributed to
+#   - a memory region, from the output section address: FLASH, RAM (SRAM1) or SRAM2;
+#     sections with a load address in flash (.data, .sram2) also count against FLASH
+#   - a module: the object file (ADC.o -> ADC), or the library for archive members
+#   - a category: text, rodata, data or bss (.ramfunc counts as text, .fastdata as data)
+#   - a symbol: from -ffunction-sections / -fdata-sections names (.text.foo -> foo) or
+#     the global symbols the map lists inside the section
+#
+# Fails (exit 1) when a region is over its budget in map_budget.json, or grew by more
+# than "max_growth" bytes compared with the stored baseline. The baseline is only
+# meaningful for the tree it was taken from: seed it (make map-baseline) from a build of
+# the current sources; while it is empty, growth is not checked.
+#
+# Usage (from the Debug directory, see makefile.targets):
+#   python3 ../Tools/map_report.py --map Final_Project_PWM.map --config ../Tools/map_budget.json
+#   ... --update-baseline   rewrite the baseline from the current map
+
+import argparse
+import json
+import os
+import re
+import sys
+from collections import defaultdict
+
+OUT_SECTION = re.compile(r'^(?P<name>[.\w]\S*)(?:\s+0x(?P<addr>[0-9a-f]+)\s+0x(?P<size>[0-9a-f]+)'
+                         r'(?:\s+load address 0x(?P<lma>[0-9a-f]+))?)?\s*$')
+IN_SECTION  = re.compile(r'^ (?P<name>[.\w*]\S*)(?:\s+0x(?P<addr>[0-9a-f]+)\s+0x(?P<size>[0-9a-f]+)'
+                         r'(?:\s+(?P<obj>.+))?)?\s*$')
+CONTINUED   = re.compile(r'^\s+0x(?P<addr>[0-9a-f]+)\s+0x(?P<size>[0-9a-f]+)(?:\s+(?P<obj>.+))?\s*$')
+SYMBOL      = re.compile(r'^\s{16}0x(?P<addr>[0-9a-f]+)\s+(?P<name>[A-Za-z_.$][\w.$]*)\s*$')
+MEMORY_LINE = re.compile(r'^(?P<name>\w+)\s+0x(?P<origin>[0-9a-f]+)\s+0x(?P<length>[0-9a-f]+)')
+
+CATEGORIES = ('text', 'rodata', 'data', 'bss')
+
+
+def category(out_name, in_name):
+    for prefix, cat in (('.text', 'text'), ('.ramfunc', 'text'), ('.glue', 'text'),
+                        ('.vfp11', 'text'), ('.v4_bx', 'text'), ('.iplt', 'text'),
+                        ('.rodata', 'rodata'), ('.isr_vector', 'rodata'), ('.ARM', 'rodata'),
+                        ('.init_array', 'rodata'), ('.fini_array', 'rodata'),
+                        ('.preinit_array', 'rodata'), ('.init', 'text'), ('.fini', 'text'),
+                        ('.data', 'data'), ('.fastdata', 'data'), ('.igot', 'data'),
+                        ('.bss', 'bss'), ('COMMON', 'bss'), ('.ram_vectors', 'bss'),
+                        ('.sram2', 'data')):
+        if in_name.startswith(prefix):
+            return cat
+    # Fill and linker-generated space: follow the output section
+    if out_name in ('.bss', '._user_heap_stack', '.sram2_vectors'):
+        return 'bss'
+    if out_name in ('.data', '.sram2'):
+        return 'data'
+    return 'rodata'
+
+
+def module_of(obj):
+    obj = obj.replace('\\', '/')
+    m = re.search(r'([^/]+)\.a\(', obj)
+    if m:
+        return m.group(1)
+    base = os.path.basename(obj)
+    if base.startswith('crt'):
+        return 'crt'
+    return base[:-2] if base.endswith('.o') else base
+
+
+def symbol_of(in_name):
+    for prefix in ('.text.', '.rodata.', '.data.', '.bss.', '.ramfunc.', '.fastdata.'):
+        if in_name.startswith(prefix):
+            return in_name[len(prefix):]
+    return None
+
+
+class MapFile:
+    def __init__(self, path):
+        self.regions = {}                    # name -> (origin, length)
+        self.entries = []                    # (region, lma_in_flash, module, category, symbol, size)
+        self.out_sections = []               # (name, addr, size, lma)
+        self._parse(path)
+
+    def region_of(self, addr):
+        for name, (origin, length) in self.regions.items():
+            if name != '*default*' and origin <= addr < origin + length:
+                return name
+        return None
+
+    def _parse(self, path):
+        with open(path, errors='replace') as f:
+            lines = [l.rstrip('\n').rstrip('\r') for l in f]
+
+        # 1. Memory Configuration
+        i = 0
+        while i < len(lines) and lines[i] != 'Memory Configuration':
+            i += 1
+        while i < len(lines) and lines[i] != 'Linker script and memory map':
+            m = MEMORY_LINE.match(lines[i])
+            if m and m.group('name') != 'Name':
+                self.regions[m.group('name')] = (int(m.group('origin'), 16), int(m.group('length'), 16))
+            i += 1
+
+        # 2. Output and input sections
+        out = None          # (name, addr, lma)
+        pending = None      # input section whose address is on the next line
+        current = None      # [in_name, addr, size, module, symbols]
+        for line in lines[i + 1:]:
+            if pending is not None:
+                m = CONTINUED.match(line)
+                if m:
+                    current = self._input(out, pending, m)
+                    pending = None
+                    continue
+                pending = None
+
+            if line and not line[0].isspace():
+                m = OUT_SECTION.match(line)
+                if m and not line.startswith(('LOAD ', 'START GROUP', 'END GROUP', 'OUTPUT(')):
+                    self._flush(current)
+                    current = None
+                    if m.group('addr') is None:
+                        out = [m.group('name'), None, None]      # address on the next line
+                    else:
+                        out = self._output(m.group('name'), m)
+                continue
+
+            if out is not None and out[1] is None:
+                m = CONTINUED.match(line)
+                if m:
+                    out = self._output(out[0], m)
+                    continue
+
+            m = IN_SECTION.match(line)
+            if m and out is not None:
+                self._flush(current)
+                current = None
+                if m.group('addr') is None:
+                    pending = m.group('name')
+                else:
+                    current = self._input(out, m.group('name'), m)
+                continue
+
+            m = SYMBOL.match(line)
+            if m and current is not None and '=' not in line:
+                current[4].append((int(m.group('addr'), 16), m.group('name')))
+        self._flush(current)
+
+    def _output(self, name, m):
+        addr = int(m.group('addr'), 16)
+        lma = m.groupdict().get('lma')
+        lma = int(lma, 16) if lma else None
+        self.out_sections.append((name, addr, int(m.group('size'), 16), lma))
+        return [name, addr, lma]
+
+    def _input(self, out, in_name, m):
+        size = int(m.group('size'), 16)
+        if out[1] is None or self.region_of(out[1]) is None or size == 0:
+            return None
+        if in_name == '*fill*':
+            # Alignment padding, or the heap / stack reservation in ._user_heap_stack
+            module = 'heap+stack' if out[0] == '._user_heap_stack' else '(fill)'
+            in_name = out[0]
+        else:
+            module = module_of(m.group('obj') or '(linker)')
+        return [in_name, int(m.group('addr'), 16), size, module, [], out]
+
+    def _flush(self, current):
+        if current is None:
+            return
+        in_name, addr, size, module, symbols, out = current
+        out_name, out_addr, out_lma = out
+        region = self.region_of(out_addr)
+        in_flash = out_lma is not None and self.region_of(out_lma) == 'FLASH' and region != 'FLASH'
+        cat = category(out_name, in_name)
+
+        # Split the input section between the global symbols it holds
+        symbols = sorted(s for s in symbols if addr <= s[0] < addr + size)
+        name = symbol_of(in_name)
+        if name is not None or not symbols:
+            parts = [(name or '(%s)' % in_name, size)]
+        else:
+            parts = []
+            if symbols[0][0] > addr:
+                parts.append(('(%s)' % in_name, symbols[0][0] - addr))
+            for k, (s_addr, s_name) in enumerate(symbols):
+                end = symbols[k + 1][0] if k + 1 < len(symbols) else addr + size
+                parts.append((s_name, end - s_addr))
+
+        for sym, sym_size in parts:
+            if sym_size > 0:
+                self.entries.append((region, in_flash, module, cat, sym, sym_size))
+
+    def summary(self):
+        regions = defaultdict(int)
+        modules = defaultdict(lambda: defaultdict(int))
+        symbols = {}
+        for region, in_flash, module, cat, sym, size in self.entries:
+            regions[region] += size
+            if in_flash:
+                regions['FLASH'] += size
+            modules[module][cat] += size
+            key = '%s:%s' % (module, sym)
+            symbols[key] = symbols.get(key, 0) + size
+        return {
+            'regions': dict(regions),
+            'modules': {m: dict(c) for m, c in modules.items()},
+            'symbols': symbols,
+        }
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Memory footprint report for the GNU ld map file')
+    ap.add_argument('--map', default='Final_Project_PWM.map')
+    ap.add_argument('--config', required=True, help='map_budget.json')
+    ap.add_argument('--top', type=int, default=15, help='symbol changes to list')
+    ap.add_argument('--update-baseline', action='store_true')
+    args = ap.parse_args()
+
+    with open(args.config) as f:
+        config = json.load(f)
+
+    mapfile = MapFile(args.map)
+    now = mapfile.summary()
+    base = {'regions': {}, 'modules': {}, 'symbols': {}}
+    base.update(config.get('baseline', {}))
+    errors = []
+    if not base['regions']:
+        print('No baseline in %s: growth not checked (seed it with --update-baseline)\n' % args.config)
+
+    # 1. Regions against budgets and baseline
+    print('Region        used   (base)    delta   budget   size')
+    for region in sorted(set(now['regions']) | set(config.get('budgets', {}))):
+        used = now['regions'].get(region, 0)
+        old = base['regions'].get(region, 0)
+        budget = config.get('budgets', {}).get(region)
+        length = mapfile.regions.get(region, (0, 0))[1]
+        print('  %-8s %7d  (%6d)  %+7d  %7s  %6d  %5.1f%%' % (
+            region, used, old, used - old, budget if budget is not None else '-', length,
+            100.0 * used / length if length else 0.0))
+        if budget is not None and used > budget:
+            errors.append('%s uses %d bytes, budget is %d' % (region, used, budget))
+        growth = config.get('max_growth', {}).get(region)
+        if growth is not None and region in base['regions'] and used - old > growth:
+            errors.append('%s grew by %d bytes (limit %d)' % (region, used - old, growth))
+
+    # 2. Per module
+    print('\nModule                 ' + ''.join('%9s' % c for c in CATEGORIES) + '    delta')
+    for module in sorted(set(now['modules']) | set(base['modules'])):
+        cur = now['modules'].get(module, {})
+        old = base['modules'].get(module, {})
+        delta = sum(cur.values()) - sum(old.values())
+        print('  %-20s ' % module + ''.join('%9d' % cur.get(c, 0) for c in CATEGORIES) +
+              ('  %+7d' % delta if delta else ''))
+
+    # 3. Largest symbol changes
+    changes = []
+    for key in set(now['symbols']) | set(base['symbols']):
+        d = now['symbols'].get(key, 0) - base['symbols'].get(key, 0)
+        if d:
+            changes.append((abs(d), d, key))
+    if changes:
+        print('\nLargest symbol changes:')
+        for _, d, key in sorted(changes, reverse=True)[:args.top]:
+            state = 'new' if key not in base['symbols'] else ('removed' if key not in now['symbols'] else '')
+            print('  %+7d  %-50s %6d  %s' % (d, key, now['symbols'].get(key, 0), state))
+
+    if args.update_baseline:
+        config['baseline'] = now
+        with open(args.config, 'w') as f:
+            json.dump(config, f, indent=2, sort_keys=True)
+            f.write('\n')
+        print('\nbaseline updated in %s' % args.config)
+        return 0
+
+    if errors:
+        print('\nFAILED:')
+        for e in errors:
+            print('  ' + e)
+        return 1
+    print('\nOK')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+#
+# profile_report.py
+#
+#  Created on: Oct 19, 2026
+#      Author: Elias Asami, Milton Salazar
+#
+# Side-by-side comparison of the build profiles of the CMake build (Debug, ReleaseSpeed,
+# ReleaseSize ...), from the files next to each Final_Project_PWM-<profile>.elf:
+#
+#   <elf>.map                 code and data size per region and category (map_report.py)
+#   bench_<profile>.json      kernel cycles/op from Bench_Run() (BENCH_ENABLE = 1), dumped
+#                             from the target:
+#                               dump binary memory bench_<profile>.json bench_json bench_json+bench_json_len
+#   probes_<profile>.bin      loop and ISR cycle statistics (PROFILE_ENABLE = 1) after a
+#                             run on the target:
+#                               dump binary value probes_<profile>.bin profile_probes
+#
+# Cycle rows are left empty ('-') for profiles without a dump. Changes are relative to the
+# first profile. --json writes the same table for scripts.
+#
+# Usage (see the firmware-report target of CMakeLists.txt):
+#   python3 Tools/profile_report.py --build-dir build-arm --profile-header Inc/profile.h \
+#           --profiles Debug ReleaseSpeed ReleaseSize
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+from collections import OrderedDict
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from map_report import MapFile, CATEGORIES   # noqa: E402
+
+PROJECT = 'Final_Project_PWM'
+PROBE_ENUM = re.compile(r'^\s*PROF_(?P<name>\w+),')
+# profile_probe_t: count, min, max, (pad), uint64 sum, hist[PROFILE_BINS]
+PROBE_FORMAT = '<III4xQ32I'
+
+
+def probe_names(header):
+    names = []
+    with open(header) as f:
+        for line in f:
+            m = PROBE_ENUM.match(line)
+            if m and m.group('name') != 'COUNT':
+                names.append(m.group('name').lower())
+    return names
+
+
+def sizes(map_path):
+    summary = MapFile(map_path).summary()
+    rows = OrderedDict()
+    for region in ('FLASH', 'RAM', 'SRAM2'):
+        rows['size %s' % region] = summary['regions'].get(region, 0)
+    for cat in CATEGORIES:
+        rows['size %s' % cat] = sum(m.get(cat, 0) for m in summary['modules'].values())
+    return rows
+
+
+def bench(path):
+    rows = OrderedDict()
+    if os.path.exists(path):
+        with open(path) as f:
+            for b in json.load(f).get('benchmarks', []):
+                if 'cycles_per_op' in b and b.get('run_type') != 'aggregate':
+                    rows['cyc/op %s' % b['name']] = b['cycles_per_op']
+    return rows
+
+
+def probes(path, names):
+    rows = OrderedDict()
+    if not os.path.exists(path):
+        return rows
+    with open(path, 'rb') as f:
+        data = f.read()
+    size = struct.calcsize(PROBE_FORMAT)
+    for i, name in enumerate(names):
+        if (i + 1) * size > len(data):
+            break
+        count, low, high, total = struct.unpack_from(PROBE_FORMAT, data, i * size)[:4]
+        if count:
+            rows['cyc mean %s' % name] = round(total / count, 1)
+            rows['cyc max %s' % name] = high
+    return rows
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Size and cycle comparison of build profiles')
+    ap.add_argument('--build-dir', required=True)
+    ap.add_argument('--profile-header', required=True, help='Inc/profile.h (probe names)')
+    ap.add_argument('--profiles', nargs='+', required=True)
+    ap.add_argument('--json', help='also write the table here')
+    args = ap.parse_args()
+
+    names = probe_names(args.profile_header)
+    table = OrderedDict()
+    for profile in args.profiles:
+        base = os.path.join(args.build_dir, '%s-%s' % (PROJECT, profile))
+        if not os.path.exists(base + '.map'):
+            print('%s: no %s.map, build the profile first' % (profile, base))
+            return 2
+        row = sizes(base + '.map')
+        row.update(bench(os.path.join(args.build_dir, 'bench_%s.json' % profile)))
+        row.update(probes(os.path.join(args.build_dir, 'probes_%s.bin' % profile), names))
+        table[profile] = row
+
+    metrics = []
+    for row in table.values():
+        metrics += [m for m in row if m not in metrics]
+    first = args.profiles[0]
+
+    print('%-28s' % 'Metric' + ''.join('%22s' % p for p in args.profiles))
+    for metric in metrics:
+        line = '  %-26s' % metric
+        ref = table[first].get(metric)
+        for profile in args.profiles:
+            value = table[profile].get(metric)
+            if value is None:
+                line += '%22s' % '-'
+            elif profile == first or not ref:
+                line += '%22s' % ('%g' % value)
+            else:
+                line += '%22s' % ('%g (%+.0f%%)' % (value, 100.0 * (value - ref) / ref))
+        print(line)
+
+    if args.json:
+        with open(args.json, 'w') as f:
+            json.dump(table, f, indent=2)
+            f.write('\n')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
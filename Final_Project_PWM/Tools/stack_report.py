@@ -0,0 +1,290 @@
+#!/usr/bin/env python3
+#
+# stack_report.py
+#
+#  Created on: Oct 19, 2026
+#      Author: Elias Asami, Milton Salazar
+#
+# Static stack and complexity budget report.
+#
+# Inputs (all produced by the Debug build):
+#   Src/*.su, Startup/*.su   per-function frame size   (-fstack-usage)
+#   Src/*.cyclo              per-function complexity   (-fcyclomatic-complexity, optional:
+#                            only the GCC of STM32CubeIDE has it)
+#   Final_Project_PWM.list   disassembly, for the call graph (bl / b.w to a symbol)
+#
+# Calls between flash and the RAMFUNCs in SRAM2 (more than 16 MB apart) go through the
+# long-branch stubs GNU ld adds (__<sym>_veneer, one ldr.w pc); they are followed to
+# <sym>, since the stub has no frame of its own.
+#
+# Calls through function pointers (blx rN) are not visible in the listing; the ones the
+# firmware makes on purpose (task table, timer callbacks, arming entry/exit actions)
+# are listed under "indirect" in stack_budget.json.
+#
+# Worst case for the MSP:
+#   main's deepest path
+#   + for every preemption level: exception frame + deepest handler at that level
+# since at most one handler per level can be active at a time.
+#
+# The levels come from the sources, not from a copy: irq_map in Src/irq_config.c with
+# the IRQ_PRIO_* values of Inc/irq_config.h, and the vector table of the startup file
+# for the handler of each IRQn (stm32l476xx.h). NMI and HardFault have their fixed
+# levels; the other system handlers keep their reset priority 0 (nothing programs SHPR).
+#
+# Fails (exit 1) when:
+#   - the worst case exceeds "stack_budget"
+#   - a function's frame or complexity grew compared with the stored baseline (complexity
+#     only when the build produced .cyclo files). The baseline is only meaningful for the
+#     tree it was taken from: seed it (make stack-baseline) from a build of the current
+#     sources; while it is empty, every function is reported as new and none fails.
+#   - the call graph has recursion or a dynamic-size frame
+#   - an interrupt handler in the image has no entry in irq_map
+#
+# Usage (from the Debug directory, see makefile.targets):
+#   python3 ../Tools/stack_report.py --build-dir . --config ../Tools/stack_budget.json
+#   ... --update-baseline   rewrite the baseline from the current build
+
+import argparse
+import glob
+import json
+import os
+import re
+import sys
+
+SU_LINE    = re.compile(r'^(?P<loc>.*):(?P<line>\d+):(?P<col>\d+):(?P<func>[^\t]+)\t(?P<bytes>\d+)\t(?P<kind>\S+)')
+CYCLO_LINE = re.compile(r'^(?P<loc>.*):(?P<line>\d+):(?P<col>\d+):(?P<func>[^\t]+)\t(?P<cyclo>\d+)')
+LIST_FUNC  = re.compile(r'^[0-9a-f]{8} <(?P<func>[^>]+)>:$')
+LIST_CALL  = re.compile(r'\s(?P<op>bl|b\.w|b|blx)(?:\.n|\.w)?\s+[0-9a-f]+ <(?P<target>[^>+]+)>')
+LIST_ICALL = re.compile(r'\sblx\s+r\d+')
+VENEER     = re.compile(r'^__(?P<sym>.+)_veneer$')
+PRIO_DEF   = re.compile(r'^#define\s+(?P<name>IRQ_PRIO_\w+)\s+(?P<value>\d+)', re.M)
+MAP_ENTRY  = re.compile(r'\{\s*(?P<irq>\w+_IRQn)\s*,\s*(?P<prio>\w+)\s*\}')
+IRQN_DEF   = re.compile(r'^\s*(?P<name>\w+_IRQn)\s*=\s*(?P<num>-?\d+)', re.M)
+VECTOR     = re.compile(r'^\s*\.word\s+(?P<name>\w+)', re.M)
+
+FIXED_PRIORITIES = {'NMI_Handler': -2, 'HardFault_Handler': -1}
+SYSTEM_HANDLERS  = ('MemManage_Handler', 'BusFault_Handler', 'UsageFault_Handler',
+                    'SVC_Handler', 'DebugMon_Handler', 'PendSV_Handler')
+
+# Cortex-M4 exception frame: 8 words, or 26 words when the FPU context is stacked
+FRAME_BASIC = 32
+FRAME_FPU   = 104
+
+
+def read_su(build_dir):
+    frames = {}
+    dynamic = set()
+    for path in glob.glob(os.path.join(build_dir, '**', '*.su'), recursive=True):
+        with open(path) as f:
+            for line in f:
+                m = SU_LINE.match(line.strip())
+                if not m:
+                    continue
+                func = m.group('func')
+                frames[func] = max(frames.get(func, 0), int(m.group('bytes')))
+                if 'dynamic' in m.group('kind') and 'bounded' not in m.group('kind'):
+                    dynamic.add(func)
+    return frames, dynamic
+
+
+def read_cyclo(build_dir):
+    cyclo = {}
+    for path in glob.glob(os.path.join(build_dir, '**', '*.cyclo'), recursive=True):
+        with open(path) as f:
+            for line in f:
+                m = CYCLO_LINE.match(line.strip())
+                if m and '/CMSIS/' not in m.group('loc').replace('\\', '/'):
+                    func = m.group('func')
+                    cyclo[func] = max(cyclo.get(func, 0), int(m.group('cyclo')))
+    return cyclo
+
+
+def read_call_graph(list_path):
+    calls = {}
+    indirect = set()
+    func = None
+    with open(list_path, errors='replace') as f:
+        for line in f:
+            m = LIST_FUNC.match(line.rstrip())
+            if m:
+                func = m.group('func')
+                calls.setdefault(func, set())
+                continue
+            if func is None:
+                continue
+            m = LIST_CALL.search(line)
+            if m:
+                v = VENEER.match(m.group('target'))
+                target = v.group('sym') if v else m.group('target')
+                if target != func:
+                    calls[func].add(target)
+            elif LIST_ICALL.search(line):
+                indirect.add(func)
+    return calls, indirect
+
+
+def read_priorities(root):
+    """Handler name -> preemption level, from irq_map and the vector table."""
+    def text(*parts):
+        with open(os.path.join(root, *parts)) as f:
+            return f.read()
+
+    levels = {m.group('name'): int(m.group('value'))
+              for m in PRIO_DEF.finditer(text('Inc', 'irq_config.h'))}
+    irqn = {m.group('name'): int(m.group('num'))
+            for m in IRQN_DEF.finditer(text('CMSIS', 'Device', 'ST', 'STM32L4xx', 'Include', 'stm32l476xx.h'))}
+    startup = text('Startup', 'startup_stm32l476rgtx.s')
+    table = startup[startup.index('g_pfnVectors:'):startup.index('.size g_pfnVectors')]
+    vectors = [m.group('name') for m in VECTOR.finditer(table)]
+
+    priorities = dict(FIXED_PRIORITIES)
+    priorities.update((h, 0) for h in SYSTEM_HANDLERS)
+    for m in MAP_ENTRY.finditer(text('Src', 'irq_config.c')):
+        priorities[vectors[16 + irqn[m.group('irq')]]] = levels[m.group('prio')]
+    return priorities
+
+
+class StackModel:
+    def __init__(self, frames, calls):
+        self.frames = frames
+        self.calls = calls
+        self.memo = {}
+        self.recursive = set()
+
+    def depth(self, func, path=()):
+        """Deepest stack use starting at func, and the call path that reaches it."""
+        if func in path:
+            self.recursive.add(func)
+            return 0, [func + ' (recursion)']
+        if func in self.memo:
+            return self.memo[func]
+        best, best_path = 0, []
+        for callee in sorted(self.calls.get(func, ())):
+            d, p = self.depth(callee, path + (func,))
+            if d > best:
+                best, best_path = d, p
+        result = (self.frames.get(func, 0) + best, [func] + best_path)
+        self.memo[func] = result
+        return result
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Static stack and complexity budget report")
+    ap.add_argument('--build-dir', default='.', help='Debug build directory')
+    ap.add_argument('--list', default=None, help='objdump listing (default: <build-dir>/Final_Project_PWM.list)')
+    ap.add_argument('--config', required=True, help='stack_budget.json')
+    ap.add_argument('--source-dir', default=os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'),
+                    help='project root, for the priority map (default: the parent of Tools/)')
+    ap.add_argument('--update-baseline', action='store_true')
+    args = ap.parse_args()
+
+    with open(args.config) as f:
+        config = json.load(f)
+
+    list_path = args.list or os.path.join(args.build_dir, 'Final_Project_PWM.list')
+    frames, dynamic = read_su(args.build_dir)
+    cyclo = read_cyclo(args.build_dir)
+    calls, indirect_callers = read_call_graph(list_path)
+    if not cyclo:
+        print('note: no .cyclo files in %s (compiler without -fcyclomatic-complexity), '
+              'complexity not checked\n' % args.build_dir)
+
+    # 1. Add the known function-pointer calls
+    for caller, targets in config.get('indirect', {}).items():
+        calls.setdefault(caller, set()).update(targets)
+    unresolved = sorted(indirect_callers - set(config.get('indirect', {})))
+
+    model = StackModel(frames, calls)
+    errors = []
+
+    # 2. Entry points: main, then every handler present in the image (Reset_Handler is
+    #    main's caller, not an interrupt)
+    handlers = sorted(f for f in calls
+                      if (f.endswith('_Handler') or f.endswith('_IRQHandler')) and f != 'Reset_Handler')
+    priorities = read_priorities(args.source_dir)
+    frame_size = FRAME_FPU if config.get('fpu_context', True) else FRAME_BASIC
+
+    main_depth, main_path = model.depth('main')
+    print('Entry point                      stack  path')
+    print('  %-30s %5d  %s' % ('main', main_depth, ' > '.join(main_path)))
+
+    levels = {}
+    for h in handlers:
+        d, p = model.depth(h)
+        prio = priorities.get(h)
+        print('  %-30s %5d  %s%s' % (h, d, ' > '.join(p), '' if prio is not None else '  [not in irq_map]'))
+        if prio is None:
+            errors.append('%s is not in irq_map (Src/irq_config.c): its level is unknown' % h)
+        if prio is not None and d > levels.get(prio, (0, None))[0]:
+            levels[prio] = (d, h)
+
+    # 3. Nesting: one handler per preemption level on top of main
+    worst = main_depth
+    print('\nWorst-case nesting (exception frame %d bytes per level):' % frame_size)
+    print('  %-30s %5d' % ('main', main_depth))
+    for prio in sorted(levels, reverse=True):
+        d, h = levels[prio]
+        worst += frame_size + d
+        print('  prio %-2d %-23s %5d' % (prio, h, frame_size + d))
+    budget = config['stack_budget']
+    print('  %-30s %5d / %d bytes' % ('total', worst, budget))
+    if worst > budget:
+        errors.append('worst-case stack %d exceeds the budget of %d bytes' % (worst, budget))
+
+    # 4. Things the static analysis cannot bound
+    for func in sorted(model.recursive):
+        errors.append('recursion through %s' % func)
+    for func in sorted(dynamic):
+        errors.append('dynamic stack frame in %s' % func)
+    for func in unresolved:
+        print('warning: indirect call in %s not listed in "indirect"' % func)
+
+    # 5. Regressions against the stored baseline
+    baseline = config.get('baseline', {})
+    limit = config.get('cyclo_limit')
+    if not baseline:
+        print('\nNo baseline in %s: regressions not checked (seed it with --update-baseline)' % args.config)
+    print('\nFunction                        frame (base)  cyclo (base)')
+    for func in sorted(set(frames) | set(cyclo)):
+        base = baseline.get(func, {})
+        fr, cy = frames.get(func), cyclo.get(func)
+        flags = []
+        if func not in baseline:
+            flags.append('new')
+        if fr is not None and 'stack' in base and fr > base['stack']:
+            flags.append('STACK+%d' % (fr - base['stack']))
+            errors.append('%s frame grew from %d to %d bytes' % (func, base['stack'], fr))
+        if cy is not None and 'cyclo' in base and cy > base['cyclo']:
+            flags.append('CYCLO+%d' % (cy - base['cyclo']))
+            errors.append('%s complexity grew from %d to %d' % (func, base['cyclo'], cy))
+        if cy is not None and limit is not None and cy > limit:
+            flags.append('over limit')
+        print('  %-30s %5s (%4s)  %5s (%4s)  %s' % (
+            func, fr if fr is not None else '-', base.get('stack', '-'),
+            cy if cy is not None else '-', base.get('cyclo', '-'), ' '.join(flags)))
+
+    if args.update_baseline:
+        # Without .cyclo files the stored complexities are kept
+        config['baseline'] = {
+            func: {k: v for k, v in (('stack', frames.get(func)),
+                                     ('cyclo', cyclo.get(func) if cyclo else baseline.get(func, {}).get('cyclo')))
+                   if v is not None}
+            for func in sorted(set(frames) | set(cyclo))
+        }
+        with open(args.config, 'w') as f:
+            json.dump(config, f, indent=2, sort_keys=True)
+            f.write('\n')
+        print('\nbaseline updated in %s' % args.config)
+        return 0
+
+    if errors:
+        print('\nFAILED:')
+        for e in errors:
+            print('  ' + e)
+        return 1
+    print('\nOK')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
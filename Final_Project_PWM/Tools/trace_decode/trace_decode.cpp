@@ -0,0 +1,327 @@
+/*
+ * trace_decode.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Elias Asami, Milton Salazar
+ *
+ *  Host decoder for the firmware event trace (Inc/trace.h).
+ *
+ *  Input, detected automatically:
+ *    - debugger dump of 'trace_buffer' (header + whole ring, oldest record at head)
+ *    - UART capture from Trace_Task (header, then records in order; a header inside the
+ *      stream marks a target reset)
+ *
+ *  Usage: trace_decode [--text] [-o out] capture.bin
+ *    default output is Chrome trace JSON (chrome://tracing, ui.perfetto.dev)
+ */
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Keep in step with Inc/trace.h
+constexpr uint32_t kMagic      = 0x45435254u;   // "TRCE"
+constexpr uint32_t kVersion    = 1;
+constexpr size_t   kHeaderSize = 24;
+constexpr size_t   kRecordSize = 8;
+
+enum TraceId : uint16_t {
+    kLost = 0,
+    kButtonEdge,
+    kArmState,
+    kAdcSample,
+    kPwmCommit,
+    kTaskOverrun,
+};
+
+// Keep in step with Inc/tasks.h and Inc/arming.h
+const char *const kTaskNames[]  = { "control", "timers", "arming", "trace", "heartbeat", "params",
+                                    "telemetry" };
+const char *const kStateNames[] = { "DISARMED", "ARMING", "ARMED" };
+
+struct Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t capacity;
+    uint32_t clock_hz;
+    uint32_t head;
+    uint32_t lost;
+};
+
+struct Event {
+    uint64_t ticks;     // unwrapped stamp, clock_hz
+    uint32_t clock_hz;
+    uint32_t session;   // incremented at every target reset seen in a stream
+    uint16_t id;
+    uint16_t arg;
+};
+
+uint32_t le32(const uint8_t *p) {
+    return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+}
+
+uint16_t le16(const uint8_t *p) {
+    return uint16_t(p[0] | p[1] << 8);
+}
+
+bool parse_header(const std::vector<uint8_t> &data, size_t off, Header &h) {
+    if (off + kHeaderSize > data.size()) {
+        return false;
+    }
+    const uint8_t *p = &data[off];
+    h.magic       = le32(p);
+    h.version     = le16(p + 4);
+    h.record_size = le16(p + 6);
+    h.capacity    = le32(p + 8);
+    h.clock_hz    = le32(p + 12);
+    h.head        = le32(p + 16);
+    h.lost        = le32(p + 20);
+    return h.magic == kMagic && h.version == kVersion && h.record_size == kRecordSize &&
+           h.clock_hz != 0;
+}
+
+// Turns 32-bit stamps into a monotonic 64-bit time. Records can be a few cycles out of
+// order (an ISR can stamp between another writer's slot reservation and its stamp),
+// so deltas are taken as signed.
+class Unwrapper {
+public:
+    uint64_t operator()(uint32_t ts) {
+        if (!started_) {
+            started_ = true;
+            now_     = ts;
+        }
+        else {
+            now_ += int64_t(int32_t(ts - last_));
+        }
+        last_ = ts;
+        return now_;
+    }
+
+private:
+    bool     started_ = false;
+    uint32_t last_    = 0;
+    uint64_t now_     = 0;
+};
+
+Event make_event(const uint8_t *p, Unwrapper &unwrap, const Header &h, uint32_t session) {
+    Event e;
+    e.ticks    = unwrap(le32(p));
+    e.clock_hz = h.clock_hz;
+    e.session  = session;
+    e.id       = le16(p + 4);
+    e.arg      = le16(p + 6);
+    return e;
+}
+
+// Debugger dump: exactly one header plus the whole ring.
+std::vector<Event> decode_dump(const std::vector<uint8_t> &data, const Header &h) {
+    std::vector<Event> events;
+    Unwrapper          unwrap;
+    uint32_t           count = h.head < h.capacity ? h.head : h.capacity;
+
+    for (uint32_t i = h.head - count; i != h.head; i++) {
+        size_t off = kHeaderSize + size_t(i % h.capacity) * kRecordSize;
+        events.push_back(make_event(&data[off], unwrap, h, 0));
+    }
+    return events;
+}
+
+// UART stream: header, records, and a new header after every target reset.
+std::vector<Event> decode_stream(const std::vector<uint8_t> &data, Header h) {
+    std::vector<Event> events;
+    Unwrapper          unwrap;
+    uint32_t           session = 0;
+    size_t             off     = kHeaderSize;
+
+    while (off + kRecordSize <= data.size()) {
+        Header next;
+        if (parse_header(data, off, next)) {
+            h      = next;
+            unwrap = Unwrapper();
+            session++;
+            off += kHeaderSize;
+            continue;
+        }
+        events.push_back(make_event(&data[off], unwrap, h, session));
+        off += kRecordSize;
+    }
+    return events;
+}
+
+double to_us(const Event &e) {
+    return double(e.ticks) * 1e6 / double(e.clock_hz);
+}
+
+std::string task_name(uint16_t index) {
+    if (index < std::size(kTaskNames)) {
+        return kTaskNames[index];
+    }
+    return "task " + std::to_string(index);
+}
+
+std::string state_name(uint16_t state) {
+    if (state < std::size(kStateNames)) {
+        return kStateNames[state];
+    }
+    return "state " + std::to_string(state);
+}
+
+void write_text(std::ostream &out, const std::vector<Event> &events) {
+    char line[160];
+
+    for (const Event &e : events) {
+        std::string what;
+        switch (e.id) {
+        case kLost:        what = "lost " + std::to_string(e.arg) + " records"; break;
+        case kButtonEdge:  what = e.arg ? "button press" : "button release"; break;
+        case kArmState:    what = "state -> " + state_name(e.arg); break;
+        case kAdcSample:   what = "adc " + std::to_string(e.arg); break;
+        case kPwmCommit:   what = "pwm " + std::to_string(e.arg) + " us"; break;
+        case kTaskOverrun: what = "overrun " + task_name(e.arg); break;
+        default:           what = "id " + std::to_string(e.id) + " arg " + std::to_string(e.arg); break;
+        }
+        std::snprintf(line, sizeof(line), "[%u] %14.3f us  %s\n", e.session, to_us(e), what.c_str());
+        out << line;
+    }
+}
+
+void write_chrome(std::ostream &out, const std::vector<Event> &events) {
+    char line[256];
+    bool first = true;
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (const Event &e : events) {
+        double      ts  = to_us(e);
+        unsigned    pid = e.session;
+        std::string name;
+
+        switch (e.id) {
+        case kButtonEdge:
+            std::snprintf(line, sizeof(line),
+                          "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"p\",\"ts\":%.3f,\"pid\":%u,\"tid\":1}",
+                          e.arg ? "press" : "release", ts, pid);
+            break;
+        case kArmState:
+            std::snprintf(line, sizeof(line),
+                          "{\"name\":\"arm_state\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":%u,"
+                          "\"args\":{\"state\":%u}}",
+                          ts, pid, e.arg);
+            out << (first ? "" : ",\n") << line;
+            first = false;
+            name  = state_name(e.arg);
+            std::snprintf(line, sizeof(line),
+                          "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"p\",\"ts\":%.3f,\"pid\":%u,\"tid\":2}",
+                          name.c_str(), ts, pid);
+            break;
+        case kAdcSample:
+            std::snprintf(line, sizeof(line),
+                          "{\"name\":\"throttle\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":%u,"
+                          "\"args\":{\"adc\":%u}}",
+                          ts, pid, e.arg);
+            break;
+        case kPwmCommit:
+            std::snprintf(line, sizeof(line),
+                          "{\"name\":\"pulse\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":%u,"
+                          "\"args\":{\"us\":%u}}",
+                          ts, pid, e.arg);
+            break;
+        case kTaskOverrun:
+            name = "overrun " + task_name(e.arg);
+            std::snprintf(line, sizeof(line),
+                          "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"p\",\"ts\":%.3f,\"pid\":%u,\"tid\":3}",
+                          name.c_str(), ts, pid);
+            break;
+        default:
+            std::snprintf(line, sizeof(line),
+                          "{\"name\":\"id %u\",\"ph\":\"i\",\"s\":\"p\",\"ts\":%.3f,\"pid\":%u,\"tid\":4,"
+                          "\"args\":{\"arg\":%u}}",
+                          e.id, ts, pid, e.arg);
+            break;
+        }
+        out << (first ? "" : ",\n") << line;
+        first = false;
+    }
+    out << "\n]}\n";
+}
+
+int usage() {
+    std::cerr << "usage: trace_decode [--text] [-o out] capture.bin\n";
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bool        text = false;
+    std::string in_path;
+    std::string out_path;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--text") {
+            text = true;
+        }
+        else if (arg == "-o" && i + 1 < argc) {
+            out_path = argv[++i];
+        }
+        else if (!arg.empty() && arg[0] != '-' && in_path.empty()) {
+            in_path = arg;
+        }
+        else {
+            return usage();
+        }
+    }
+    if (in_path.empty()) {
+        return usage();
+    }
+
+    std::ifstream in(in_path, std::ios::binary);
+    if (!in) {
+        std::cerr << "trace_decode: cannot open " << in_path << "\n";
+        return 1;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    // A UART capture can start mid-record; skip to the first header
+    size_t start = 0;
+    Header h;
+    while (start + kHeaderSize <= data.size() && !parse_header(data, start, h)) {
+        start++;
+    }
+    if (start + kHeaderSize > data.size()) {
+        std::cerr << "trace_decode: no trace header in " << in_path << "\n";
+        return 1;
+    }
+    data.erase(data.begin(), data.begin() + std::ptrdiff_t(start));
+
+    bool dump = data.size() == kHeaderSize + size_t(h.capacity) * kRecordSize;
+    std::vector<Event> events = dump ? decode_dump(data, h) : decode_stream(data, h);
+
+    if (h.lost != 0 && dump) {
+        std::cerr << "trace_decode: " << h.lost << " records were dropped by the UART drain\n";
+    }
+
+    std::ofstream file;
+    if (!out_path.empty()) {
+        file.open(out_path);
+        if (!file) {
+            std::cerr << "trace_decode: cannot write " << out_path << "\n";
+            return 1;
+        }
+    }
+    std::ostream &out = out_path.empty() ? std::cout : file;
+
+    if (text) {
+        write_text(out, events);
+    }
+    else {
+        write_chrome(out, events);
+    }
+    return 0;
+}
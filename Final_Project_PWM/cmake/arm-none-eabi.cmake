@@ -0,0 +1,36 @@
+# Toolchain file for the STM32L476RG (Cortex-M4F) with the GNU Arm Embedded toolchain.
+#
+#   cmake -S . -B build-arm -DCMAKE_TOOLCHAIN_FILE=cmake/arm-none-eabi.cmake
+#
+# The toolchain is looked up on PATH; set ARM_TOOLCHAIN_DIR to use another one (e.g. the
+# one bundled with STM32CubeIDE).
+set(CMAKE_SYSTEM_NAME      Generic)
+set(CMAKE_SYSTEM_PROCESSOR arm)
+
+set(ARM_TOOLCHAIN_DIR "" CACHE PATH "Directory holding arm-none-eabi-gcc (empty: PATH)")
+if(ARM_TOOLCHAIN_DIR)
+    set(_prefix ${ARM_TOOLCHAIN_DIR}/arm-none-eabi-)
+else()
+    set(_prefix arm-none-eabi-)
+endif()
+
+set(CMAKE_C_COMPILER   ${_prefix}gcc)
+set(CMAKE_ASM_COMPILER ${_prefix}gcc)
+set(CMAKE_AR           ${_prefix}gcc-ar)
+set(CMAKE_RANLIB       ${_prefix}gcc-ranlib)
+set(CMAKE_OBJCOPY      ${_prefix}objcopy CACHE FILEPATH "")
+set(CMAKE_OBJDUMP      ${_prefix}objdump CACHE FILEPATH "")
+set(CMAKE_SIZE         ${_prefix}size    CACHE FILEPATH "")
+
+# No OS to link test programs against
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
+
+# Core flags, as in the IDE build (Debug/makefile)
+set(ARM_CPU_FLAGS "-mcpu=cortex-m4 -mthumb -mfpu=fpv4-sp-d16 -mfloat-abi=hard")
+set(CMAKE_C_FLAGS_INIT   "${ARM_CPU_FLAGS}")
+set(CMAKE_ASM_FLAGS_INIT "${ARM_CPU_FLAGS} -x assembler-with-cpp")
+set(CMAKE_EXE_LINKER_FLAGS_INIT "${ARM_CPU_FLAGS} --specs=nano.specs --specs=nosys.specs -static")
+
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)